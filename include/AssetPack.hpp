@@ -0,0 +1,85 @@
+#ifndef ASSET_PACK_HPP
+#define ASSET_PACK_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "engine/resource-system/binary/include.hpp"
+#include "init/asset-tables.hpp"
+
+enum class AssetSection : uint32_t {
+    Tiles,
+    Animations,
+    Species,
+    Moves,
+    Encounters
+};
+
+/**
+ * \brief A memory-mapped binary pack of the data tables, baked offline
+ * from the JSON files.
+ *
+ * Each section stores the size and modification time of the JSON file it
+ * was baked from, so a section whose file changed since is reported as out
+ * of date, without reading the file, and should be read from JSON instead.
+ * A hash of the file's contents is stored too, which validate() checks.
+ * Records are stored sorted by id, each one prefixed by its id and size.
+ */
+class AssetPack {
+    using BinaryReader = engine::resourcesystem::BinaryReader;
+    using MappedFile = engine::resourcesystem::MappedFile;
+ public:
+    static constexpr uint32_t VERSION = 3;
+    static constexpr size_t NUM_SECTIONS = 5;
+
+    /**
+     * \brief Maps a pack. Throws std::runtime_error if the file can't be
+     * read or isn't a pack of the current version.
+     */
+    explicit AssetPack(const std::string& filename);
+
+    /**
+     * \brief Reads all tables from the JSON files and writes them to a
+     * pack. Throws std::runtime_error if the file can't be written.
+     */
+    static void bake(const std::string& filename);
+
+    /**
+     * \brief Checks whether a section's JSON file still has the size and
+     * modification time it had when the section was baked. Only the file's
+     * metadata is read, so a file rewritten with the same contents counts
+     * as changed.
+     */
+    bool isUpToDate(AssetSection) const;
+
+    AssetTable<TileData> tiles() const;
+    AssetTable<AnimationRecord> animations() const;
+    AssetTable<PokemonSpeciesData> species() const;
+    AssetTable<Move> moves() const;
+    AssetTable<MapEncounterData> encounters() const;
+
+    /**
+     * \brief Compares the hash of each JSON file and every record with the
+     * JSON files. Returns a description of each mismatch, or nothing if the
+     * pack matches.
+     */
+    std::vector<std::string> validate() const;
+
+ private:
+    struct Section {
+        uint32_t numRecords = 0;
+        uint64_t sourceHash = 0;
+        uint64_t sourceSize = 0;
+        uint64_t sourceModified = 0;
+        BinaryReader records;
+    };
+
+    MappedFile file;
+    std::array<Section, NUM_SECTIONS> sections;
+
+    template<typename T>
+    AssetTable<T> readTable(AssetSection) const;
+};
+
+#endif
@@ -1,17 +1,23 @@
 #ifndef GAME_LOGIC_HPP
 #define GAME_LOGIC_HPP
 
+#include <memory>
+#include <string>
 #include "engine/entity-system/forward-declarations.hpp"
 #include "engine/game-loop/forward-declarations.hpp"
 #include "engine/input-system/include.hpp"
 #include "engine/resource-system/forward-declarations.hpp"
+#include "engine/resource-system/ResourceLoader.hpp"
 #include "engine/state-system/include.hpp"
+#include "engine/utils/timing/Timeline.hpp"
 #include "CoreStructures.hpp"
+#include "HotReloader.hpp"
 
 class GameLogic {
     using ComponentManager = engine::entitysystem::ComponentManager;
     using InputDispatcher = engine::inputsystem::InputDispatcher;
     using InputTracker = engine::inputsystem::InputTracker;
+    using ResourceLoader = engine::resourcesystem::ResourceLoader;
     using ResourceStorage = engine::resourcesystem::ResourceStorage;
     using SingleThreadGameLoop = engine::gameloop::SingleThreadGameLoop;
     using StateMachine = engine::statesystem::StateMachine;
@@ -26,6 +32,21 @@ class GameLogic {
     InputDispatcher inputDispatcher;
     StateMachine stateMachine;
     CoreStructures gameData;
+    // Resources are committed between frames until the loader finishes,
+    // after which it's destroyed and the initial state is pushed
+    std::unique_ptr<ResourceLoader> resourceLoader;
+    // Spans from the start of loading to the end of finishLoading()
+    engine::utils::TimelineEvent loadingEvent;
+    // Only created if hot reloading is enabled in the settings
+    std::unique_ptr<HotReloader> hotReloader;
+    // ECS stats are appended as JSON lines every statsInterval frames
+    int statsInterval;
+    std::string statsFile;
+    int frameCount = 0;
+
+    void exportStats();
+    void finishLoading();
+    void reportStartup();
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include "engine/entity-system/forward-declarations.hpp"
 #include "engine/game-loop/forward-declarations.hpp"
 #include "engine/resource-system/forward-declarations.hpp"
+#include "render.hpp"
 
 class GameRenderer {
     using ComponentManager = engine::entitysystem::ComponentManager;
@@ -20,6 +21,7 @@ class GameRenderer {
     sf::View view;
     ComponentManager& componentManager;
     ResourceStorage& resourceStorage;
+    RenderHandles renderHandles;
 
     void adjustView();
 };
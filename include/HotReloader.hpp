@@ -0,0 +1,96 @@
+#ifndef HOT_RELOADER_HPP
+#define HOT_RELOADER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "engine/entity-system/forward-declarations.hpp"
+#include "engine/resource-system/FileWatcher.hpp"
+#include "engine/resource-system/forward-declarations.hpp"
+#include "init/asset-tables.hpp"
+#include "ResourceFiles.hpp"
+
+/**
+ * \brief Development tool that applies changes to the JSON data files and
+ * the Lua scripts while the game runs.
+ *
+ * Only the records of a file that actually changed are re-read, and they
+ * replace the stored ones in place, so existing references see the new
+ * data. Each file is parsed in the background and its changes are applied
+ * all at once between two frames. Maps are also replaced in the entities
+ * that use them, and a changed script is run again in a new state. Records
+ * removed from a file are kept, and files whose resources can't be swapped
+ * (fonts, textures, sounds, music, animations, controls and settings) are
+ * only reported.
+ */
+class HotReloader {
+    using ComponentManager = engine::entitysystem::ComponentManager;
+    using FileWatcher = engine::resourcesystem::FileWatcher;
+    using ResourceLoader = engine::resourcesystem::ResourceLoader;
+    using ResourceStorage = engine::resourcesystem::ResourceStorage;
+ public:
+    /**
+     * \brief Where the watched folders and the reloaded data files are. The
+     * data files must be in the JSON folder.
+     */
+    struct Paths {
+        std::string jsonFolder = ResourceFiles::JSON_FOLDER;
+        std::string scriptsFolder = ResourceFiles::SCRIPTS_FOLDER;
+        std::string encounters = ResourceFiles::ENCOUNTERS;
+        std::string maps = ResourceFiles::MAPS;
+        std::string moves = ResourceFiles::MOVES;
+        std::string pokemon = ResourceFiles::POKEMON;
+        std::string tiles = ResourceFiles::TILES;
+    };
+
+    /**
+     * \brief Starts watching the JSON and script folders. Must be created
+     * after all resources are loaded. Throws std::runtime_error if the
+     * folders can't be watched.
+     */
+    HotReloader(ResourceStorage&, ComponentManager&, Paths);
+    ~HotReloader();
+
+    /**
+     * \brief Applies the changes of every file whose reload finished, and
+     * starts reloading the files that changed since. Must be called between
+     * frames, on the thread that renders.
+     */
+    void update();
+
+ private:
+    using Digests = std::unordered_map<std::string, uint64_t>;
+
+    ResourceStorage& storage;
+    ComponentManager& manager;
+    Paths paths;
+    FileWatcher watcher;
+    std::unique_ptr<ResourceLoader> loader;
+    // Files that changed while the previous ones were being reloaded
+    std::vector<std::string> changedFiles;
+    // Digest of each record of the data files, by file and record id
+    std::unordered_map<std::string, Digests> digests;
+    // Needed to rebuild maps when the tiles they use change
+    AssetTable<MapRecord> maps;
+
+    void reload(const std::string& filename);
+    void reloadScript(const std::string& filename, const std::string& id);
+    void reloadMaps();
+    void rebuildMaps(const std::vector<std::string>& tileIds);
+    void replaceMap(const std::string& id, const MapRecord&);
+
+    // Replaces the changed records of a data file, then calls `applied`
+    // with their ids
+    template<typename T>
+    void reloadTable(
+        const std::string& filename,
+        const std::string& prefix,
+        AssetTable<T> (*read)(const JsonValue&),
+        std::function<void(const std::vector<std::string>&)> applied = nullptr
+    );
+};
+
+#endif
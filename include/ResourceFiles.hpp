@@ -14,6 +14,7 @@ namespace ResourceFiles {
     constexpr auto SOUND_EFFECTS = "resources/json/sfx.json";
     constexpr auto TEXTURES = "resources/json/textures.json";
     constexpr auto TILES = "resources/json/tiles.json";
+    constexpr auto JSON_FOLDER = "resources/json/";
     constexpr auto SCRIPTS_FOLDER = "resources/scripts/";
 }
 
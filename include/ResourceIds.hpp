@@ -0,0 +1,17 @@
+#ifndef RESOURCE_IDS_HPP
+#define RESOURCE_IDS_HPP
+
+#include "engine/resource-system/ResourceStorage.hpp"
+
+// Identifiers of the resources looked up on hot paths, hashed at compile time
+namespace ResourceIds {
+    using engine::resourcesystem::ResourceId;
+
+    constexpr ResourceId BATTLE_EVENT_QUEUE = "battle-event-queue";
+    constexpr ResourceId LOADING_PROGRESS = "loading-progress";
+    constexpr ResourceId MOVE_EVENT_QUEUE = "move-event-queue";
+    constexpr ResourceId PLAYER_EVENT_QUEUE = "player-event-queue";
+    constexpr ResourceId POKEMON_SPRITES = "pokemon-sprites";
+}
+
+#endif
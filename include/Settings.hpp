@@ -17,6 +17,14 @@ class Settings {
     int getTileSize() const;
     std::string getPokemonBackSpritesFolder() const;
     std::string getPokemonFrontSpritesFolder() const;
+    size_t getPokemonSpriteCacheBudget() const;
+    unsigned getPokemonSpriteSize() const;
+    unsigned getMaxAtlasSize() const;
+    std::string getAssetPackFile() const;
+    bool getHotReload() const;
+    int getECSStatsInterval() const;
+    std::string getECSStatsFile() const;
+    std::string getStartupTraceFile() const;
 
  private:
     JsonValue data;
@@ -4,16 +4,20 @@
 #include <deque>
 #include <vector>
 #include "../engine/entity-system/types.hpp"
+#include "../engine/resource-system/ResourceStorage.hpp"
 #include "EventManager.hpp"
 #include "ScriptVariables.hpp"
 
 struct BoundMove;
 struct CoreStructures;
+class EventQueue;
 struct Pokemon;
 class TextProvider;
 
 class BattleController {
     using Entity = engine::entitysystem::Entity;
+    template<typename T>
+    using ResourceHandle = engine::resourcesystem::ResourceHandle<T>;
  public:
     enum class State {
         PENDING_START,
@@ -44,6 +48,8 @@ class BattleController {
     ScriptVariables scriptVariables;
     EventManager eventManager;
     State state;
+    ResourceHandle<EventQueue> battleEventQueue;
+    ResourceHandle<EventQueue> moveEventQueue;
 
     void sortUsedMoves(std::vector<BoundMove>& usedMoves);
     void updateActiveFlags();
@@ -0,0 +1,115 @@
+#ifndef POKEMON_SPRITE_CACHE_HPP
+#define POKEMON_SPRITE_CACHE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <future>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class SpriteSide {
+    Back,
+    Front
+};
+
+/**
+ * \brief Loads Pokémon sprites on first use and keeps the most recently
+ * used ones in memory, up to a byte budget.
+ *
+ * Cached sprites share one atlas texture, split into square slots of
+ * `spriteSize` pixels, as many as fit in the budget (at least two), so
+ * drawing several of them doesn't switch textures. Prefetched sprite files
+ * are decoded in the background, and the others when first requested.
+ * Sprites are only uploaded to the GPU when requested once decoded. All
+ * methods must be called from the thread that renders.
+ */
+class PokemonSpriteCache {
+ public:
+    /**
+     * \brief Throws std::invalid_argument if the budget or the sprite size
+     * is 0, or if the atlas would be too large to address.
+     */
+    PokemonSpriteCache(
+        const std::string& backSpritesFolder,
+        const std::string& frontSpritesFolder,
+        size_t budget,
+        unsigned spriteSize
+    );
+
+    /**
+     * \brief Returns a sprite showing a species. If it isn't cached yet and
+     * wasn't prefetched, its file is decoded before returning.
+     *
+     * An empty sf::Sprite, which draws nothing, is returned instead while a
+     * prefetched file is still being decoded. It's also returned while every
+     * slot holds a sprite requested in the current frame. The caller then
+     * shows at least one blank frame, so sprites should be prefetched early
+     * enough.
+     *
+     * The sprite shows the right image until a later call to get() evicts
+     * it, which never happens to the sprites requested since the last call
+     * to nextFrame(). Throws std::runtime_error if the sprite can't be
+     * loaded or is larger than a slot.
+     */
+    sf::Sprite get(const std::string& species, SpriteSide);
+
+    /**
+     * \brief Starts decoding the sprite of a species in the background,
+     * unless it's already cached or being decoded.
+     */
+    void prefetch(const std::string& species, SpriteSide);
+
+    /**
+     * \brief Starts a new frame, allowing the sprites requested during the
+     * previous one to be evicted.
+     */
+    void nextFrame();
+
+    /**
+     * \brief Returns the number of bytes of the atlas used by the cached
+     * sprites.
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * \brief Returns the number of cached sprites.
+     */
+    size_t size() const;
+
+    /**
+     * \brief Returns the number of sprites that fit in the atlas.
+     */
+    size_t capacity() const;
+
+ private:
+    struct Entry {
+        std::string key;
+        size_t slot;
+        sf::IntRect rect;
+        // Frame of the last get() that returned it
+        size_t frame;
+    };
+
+    std::string backSpritesFolder;
+    std::string frontSpritesFolder;
+    unsigned spriteSize;
+    size_t numSlots;
+    unsigned columns;
+    // Created on first use, since it needs the graphics context
+    sf::Texture atlas;
+    bool atlasCreated = false;
+    size_t frame = 0;
+    std::vector<size_t> freeSlots;
+    // Most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entryIndex;
+    std::unordered_map<std::string, std::future<sf::Image>> pendingImages;
+
+    std::string path(const std::string& species, SpriteSide) const;
+    size_t slotBytes() const;
+    bool canAllocateSlot() const;
+    size_t allocateSlot();
+};
+
+#endif
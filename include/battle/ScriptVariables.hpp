@@ -1,7 +1,9 @@
 #ifndef SCRIPT_VARIABLES_HPP
 #define SCRIPT_VARIABLES_HPP
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include "../engine/entity-system/types.hpp"
 #include "../engine/scripting-system/forward-declarations.hpp"
 
@@ -14,6 +16,7 @@ struct CoreStructures;
 class ScriptVariables {
     using Entity = engine::entitysystem::Entity;
     using Lua = engine::scriptingsystem::Lua;
+    using Tick = engine::entitysystem::Tick;
  public:
     ScriptVariables() = default;
     explicit ScriptVariables(CoreStructures& gameData);
@@ -24,7 +27,8 @@ class ScriptVariables {
     void setBattle(Battle&);
 
     /**
-     * \brief Updates the universal script variables.
+     * \brief Updates the universal script variables. Only the Pokémon whose
+     * data changed since the last update of each script are pushed again.
      */
     void updateScriptVariables();
 
@@ -39,11 +43,21 @@ class ScriptVariables {
     void updateScriptTargetPointer(Entity target);
 
  private:
+    struct SyncedScript {
+        uint64_t stateId = 0;
+        Tick tick = 0;
+    };
+
     Battle* battle;
     CoreStructures* gameData;
+    // Change tick up to which each script has received the Pokémon data.
+    // Hot reloading replaces a script in place, so the state id tells a
+    // reloaded script, which has none of the data, apart.
+    std::unordered_map<const Lua*, SyncedScript> syncedScripts;
 
     std::string findPokemonVariable(Entity);
     void updateScriptVariables(Lua&);
+    bool hasPokemonChangedSince(Entity, Tick) const;
     void updatePokemonVariables(Entity, const std::string& varName, Lua&);
 };
 
@@ -1,8 +1,10 @@
 #ifndef BATTLE_SETUP_HPP
 #define BATTLE_SETUP_HPP
 
+#include <cstddef>
 #include <string>
 #include <utility>
+#include "../../engine/entity-system/forward-declarations.hpp"
 #include "../../engine/entity-system/types.hpp"
 
 struct CoreStructures;
@@ -13,4 +15,10 @@ void setupWildEncounter(
     CoreStructures& gameData
 );
 
+/**
+ * \brief Destroys a battle entity and the Pokémon of both of its teams,
+ * returning the number of bytes reclaimed from the component storages.
+ */
+size_t teardownBattle(engine::entitysystem::Entity battle, CoreStructures& gameData);
+
 #endif
@@ -4,11 +4,15 @@
 #include <SFML/Graphics.hpp>
 #include "../engine/entity-system/forward-declarations.hpp"
 #include "../engine/resource-system/forward-declarations.hpp"
+#include "../engine/resource-system/ResourceStorage.hpp"
+
+class PokemonSpriteCache;
 
 void renderBattle(
     sf::RenderWindow&,
     engine::entitysystem::ComponentManager&,
-    engine::resourcesystem::ResourceStorage&
+    engine::resourcesystem::ResourceStorage&,
+    engine::resourcesystem::ResourceHandle<PokemonSpriteCache> spriteCache
 );
 
 #endif
@@ -6,6 +6,7 @@
 #include "../TextProvider.hpp"
 #include "CoreStructures.hpp"
 #include "EventQueue.hpp"
+#include "ResourceIds.hpp"
 
 class EventTextProvider : public TextProvider {
     using Entity = engine::entitysystem::Entity;
@@ -15,7 +16,7 @@ class EventTextProvider : public TextProvider {
         Entity battleEntity,
         CoreStructures& gameData
     ) override {
-        EventQueue& queue = gameData.resourceStorage->get<EventQueue>("battle-event-queue");
+        EventQueue& queue = gameData.resourceStorage->get<EventQueue>(ResourceIds::BATTLE_EVENT_QUEUE);
         queue.addEvent(std::make_unique<TextEvent>(content, battleEntity, gameData));
     }
 
@@ -24,7 +25,7 @@ class EventTextProvider : public TextProvider {
         Entity battleEntity,
         CoreStructures& gameData
     ) override {
-        EventQueue& queue = gameData.resourceStorage->get<EventQueue>("move-event-queue");
+        EventQueue& queue = gameData.resourceStorage->get<EventQueue>(ResourceIds::MOVE_EVENT_QUEUE);
         queue.addEvent(std::make_unique<TextEvent>(content, battleEntity, gameData));
     }
 };
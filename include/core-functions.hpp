@@ -1,6 +1,7 @@
 #ifndef CORE_FUNCTIONS_HPP
 #define CORE_FUNCTIONS_HPP
 
+#include <utility>
 #include <SFML/Audio.hpp>
 #include "engine/entity-system/include.hpp"
 #include "engine/input-system/include.hpp"
@@ -50,6 +51,11 @@ inline TComponent& data(engine::entitysystem::Entity entity, CoreStructures& gam
     return gameData.componentManager->getData<TComponent>(entity);
 }
 
+template<typename TComponent>
+inline const TComponent& readData(engine::entitysystem::Entity entity, CoreStructures& gameData) {
+    return std::as_const(*gameData.componentManager).getData<TComponent>(entity);
+}
+
 inline void enableInputContext(const std::string& id, CoreStructures& gameData) {
     gameData.inputDispatcher->enableContext(id);
 }
@@ -59,10 +65,21 @@ inline void disableInputContext(const std::string& id, CoreStructures& gameData)
 }
 
 template<typename TResource>
-inline TResource& resource(const std::string& id, CoreStructures& gameData) {
+inline TResource& resource(
+    const engine::resourcesystem::ResourceId& id,
+    CoreStructures& gameData
+) {
     return gameData.resourceStorage->get<TResource>(id);
 }
 
+template<typename TResource>
+inline TResource& resource(
+    engine::resourcesystem::ResourceHandle<TResource> handle,
+    CoreStructures& gameData
+) {
+    return gameData.resourceStorage->get(handle);
+}
+
 inline engine::scriptingsystem::Lua& script(const std::string& id, CoreStructures& gameData) {
     using engine::scriptingsystem::Lua;
     return gameData.resourceStorage->get<Lua>(id);
@@ -0,0 +1,190 @@
+#ifndef ENTITY_SYSTEM_COMMAND_BUFFER_HPP
+#define ENTITY_SYSTEM_COMMAND_BUFFER_HPP
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ComponentManager.hpp"
+#include "types.hpp"
+
+namespace engine::entitysystem {
+    /**
+     * \brief Records structural changes (entity creation and deletion,
+     * component additions and removals) so that they can be applied later,
+     * at a point where no component storage is being iterated.
+     *
+     * Entities created through the buffer don't exist until playback().
+     * Until then, createEntity() returns a placeholder handle that is only
+     * meaningful to this buffer, and that can be used in further commands
+     * recorded in it.
+     *
+     * Recording is thread-safe, so a buffer can be shared by the callbacks
+     * of a parallelForEachEntity().
+     */
+    class CommandBuffer {
+     public:
+        /**
+         * \brief Records the creation of an entity, returning its placeholder.
+         */
+        Entity createEntity();
+        /**
+         * \brief Records a ComponentManager::deleteEntity() call.
+         */
+        void deleteEntity(Entity);
+        /**
+         * \brief Records the addition of a default-initialized T component.
+         */
+        template<typename T>
+        void addComponent(Entity);
+        /**
+         * \brief Records the addition of a T component with the given data.
+         */
+        template<typename T>
+        void addComponent(Entity, T&&);
+        /**
+         * \brief Records the removal of a T component.
+         */
+        template<typename T>
+        void removeComponent(Entity);
+
+        /**
+         * \brief Checks if there are no recorded commands.
+         */
+        bool empty() const;
+        /**
+         * \brief Applies all recorded commands to a ComponentManager, in the
+         * order they were recorded, and clears the buffer.
+         *
+         * Throws std::invalid_argument, without applying any command, if one
+         * of them refers to a placeholder that wasn't returned by this buffer
+         * since the last playback.
+         */
+        void playback(ComponentManager&);
+
+     private:
+        struct Command {
+            explicit Command(Entity entity) : entity(entity) {}
+            virtual ~Command() = default;
+            virtual void apply(ComponentManager&, Entity) = 0;
+
+            Entity entity;
+        };
+
+        template<typename Functor>
+        struct CommandImpl : Command {
+            CommandImpl(Entity entity, Functor fn) : Command(entity), fn(std::move(fn)) {}
+
+            void apply(ComponentManager& manager, Entity entity) override {
+                fn(manager, entity);
+            }
+
+            Functor fn;
+        };
+
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<Command>> commands;
+        Entity::Index numPendingEntities = 0;
+
+        template<typename Functor>
+        void record(Entity, Functor&&);
+        static bool isPlaceholder(Entity);
+    };
+
+    inline Entity CommandBuffer::createEntity() {
+        auto create = [](ComponentManager&, Entity) {};
+        std::lock_guard<std::mutex> lock(mutex);
+        // Placeholders use the version that live entities never have
+        Entity placeholder{numPendingEntities++, 0};
+        commands.emplace_back(new CommandImpl<decltype(create)>(placeholder, create));
+        return placeholder;
+    }
+
+    inline void CommandBuffer::deleteEntity(Entity entity) {
+        record(entity, [](ComponentManager& manager, Entity entity) {
+            manager.deleteEntity(entity);
+        });
+    }
+
+    template<typename T>
+    inline void CommandBuffer::addComponent(Entity entity) {
+        record(entity, [](ComponentManager& manager, Entity entity) {
+            manager.addComponent<T>(entity);
+        });
+    }
+
+    template<typename T>
+    inline void CommandBuffer::addComponent(Entity entity, T&& data) {
+        using TComponent = std::decay_t<T>;
+
+        record(entity, [data = TComponent(std::forward<T>(data))](
+            ComponentManager& manager,
+            Entity entity
+        ) mutable {
+            manager.addComponent(entity, std::move(data));
+        });
+    }
+
+    template<typename T>
+    inline void CommandBuffer::removeComponent(Entity entity) {
+        record(entity, [](ComponentManager& manager, Entity entity) {
+            manager.removeComponent<T>(entity);
+        });
+    }
+
+    inline bool CommandBuffer::empty() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return commands.empty();
+    }
+
+    inline void CommandBuffer::playback(ComponentManager& manager) {
+        std::vector<std::unique_ptr<Command>> pending;
+        Entity::Index numPlaceholders;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.swap(commands);
+            numPlaceholders = numPendingEntities;
+            numPendingEntities = 0;
+        }
+
+        for (auto& command : pending) {
+            if (isPlaceholder(command->entity) && command->entity.index >= numPlaceholders) {
+                throw std::invalid_argument("CommandBuffer: unknown placeholder entity");
+            }
+        }
+
+        std::vector<Entity> createdEntities;
+        createdEntities.reserve(numPlaceholders);
+
+        for (auto& command : pending) {
+            Entity entity = command->entity;
+
+            if (isPlaceholder(entity)) {
+                if (entity.index == createdEntities.size()) {
+                    createdEntities.push_back(manager.createEntity());
+                }
+
+                entity = createdEntities[entity.index];
+            }
+
+            command->apply(manager, entity);
+        }
+    }
+
+    template<typename Functor>
+    inline void CommandBuffer::record(Entity entity, Functor&& fn) {
+        using TCommand = CommandImpl<std::decay_t<Functor>>;
+        std::unique_ptr<Command> command(new TCommand(entity, std::forward<Functor>(fn)));
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back(std::move(command));
+    }
+
+    inline bool CommandBuffer::isPlaceholder(Entity entity) {
+        return entity.version == 0;
+    }
+}
+
+#endif
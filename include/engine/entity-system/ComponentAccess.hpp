@@ -0,0 +1,94 @@
+#ifndef ENTITY_SYSTEM_COMPONENT_ACCESS_HPP
+#define ENTITY_SYSTEM_COMPONENT_ACCESS_HPP
+
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <type_traits>
+#include "Signature.hpp"
+
+namespace engine::entitysystem {
+    namespace __detail {
+        // Number of active readers of each component type, or -1 if it's
+        // being written, indexed by component ID
+        using AccessStates = std::array<std::atomic<int>, maxComponentTypes>;
+
+        template<typename T>
+        bool tryAcquireAccess(AccessStates& states) {
+            auto& state = states[componentId<std::remove_const_t<T>>()];
+            int current = state.load();
+
+            if constexpr (std::is_const_v<T>) {
+                while (current >= 0) {
+                    if (state.compare_exchange_weak(current, current + 1)) {
+                        return true;
+                    }
+                }
+
+                return false;
+            } else {
+                int expected = 0;
+                return state.compare_exchange_strong(expected, -1);
+            }
+        }
+
+        template<typename T>
+        void releaseAccess(AccessStates& states) {
+            auto& state = states[componentId<std::remove_const_t<T>>()];
+
+            if constexpr (std::is_const_v<T>) {
+                --state;
+            } else {
+                state = 0;
+            }
+        }
+    }
+
+    /**
+     * \brief Declares read (`const T`) or write (`T`) access to a set of
+     * component types of a ComponentManager, given by its access states,
+     * for as long as the object lives. Any number of
+     * readers may share a component type, but a writer requires exclusive
+     * access. Throws std::logic_error if the requested access conflicts
+     * with an access that is already active.
+     */
+    template<typename... Ts>
+    class ComponentAccess {
+     public:
+        explicit ComponentAccess(__detail::AccessStates&);
+        ~ComponentAccess();
+
+        ComponentAccess(const ComponentAccess&) = delete;
+        ComponentAccess& operator=(const ComponentAccess&) = delete;
+
+     private:
+        __detail::AccessStates& states;
+        bool acquired[sizeof...(Ts)];
+
+        void releaseAcquired();
+    };
+
+    template<typename... Ts>
+    inline ComponentAccess<Ts...>::ComponentAccess(__detail::AccessStates& states)
+     : states(states), acquired{__detail::tryAcquireAccess<Ts>(states)...} {
+        for (bool success : acquired) {
+            if (!success) {
+                releaseAcquired();
+                throw std::logic_error("Conflicting access to a component type");
+            }
+        }
+    }
+
+    template<typename... Ts>
+    inline ComponentAccess<Ts...>::~ComponentAccess() {
+        releaseAcquired();
+    }
+
+    template<typename... Ts>
+    inline void ComponentAccess<Ts...>::releaseAcquired() {
+        size_t i = 0;
+        ((acquired[i++] ? __detail::releaseAccess<Ts>(states) : void()), ...);
+    }
+}
+
+#endif
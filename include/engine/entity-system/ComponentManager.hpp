@@ -1,47 +1,95 @@
 #ifndef ENTITY_SYSTEM_COMPONENT_MANAGER_HPP
 #define ENTITY_SYSTEM_COMPONENT_MANAGER_HPP
 
+#include <algorithm>
+#include <array>
 #include <functional>
-#include <unordered_map>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../utils/threading/ThreadPool.hpp"
+#include "ComponentAccess.hpp"
+#include "ComponentStats.hpp"
+#include "Group.hpp"
+#include "QueryCache.hpp"
+#include "Signature.hpp"
+#include "SparseSet.hpp"
 #include "types.hpp"
 
 namespace engine::entitysystem {
     namespace __detail {
         struct Deleted {};
 
-        template<typename Key, typename T>
-        T& typeMap() {
-            static T value;
-            return value;
-        }
-
-        template<typename TComponent>
-        using EntityDataStorage = std::unordered_map<Entity, TComponent>;
-
-        using DeletedData = EntityDataStorage<Deleted>;
+        /**
+         * \brief Per-entity bookkeeping, indexed by Entity::index.
+         */
+        struct EntityRegistry {
+            std::vector<Signature> signatures;
+            std::vector<Entity::Version> versions;
+            std::vector<Entity::Index> freeIndices;
+        };
 
         template<typename TComponent>
-        EntityDataStorage<TComponent>& entityData() {
-            return typeMap<TComponent, EntityDataStorage<TComponent>>();
+        TComponent& tagInstance() {
+            static TComponent instance;
+            return instance;
         }
     }
 
+    template<typename T, typename... Ts>
+    class Query;
+
     /**
      * \brief Manages the game entities and their components.
      *
      * In the Component-Entity-System architecture, entities are simple GUIDs.
+     * Here they are index/version pairs: indexes of destroyed entities are
+     * reused by createEntity(), and the version tells stale handles apart.
      * Components by themselves have no logic and can be bound to entities to
      * add data to them. All the game logic is implemented by systems, which
      * operate on the data bound to the entities.
+     *
+     * Each entity has a Signature with one bit per component type it has, so
+     * membership tests are a single bitwise comparison. Components without
+     * data members (e.g `Fainted`) are tags: they only exist as that bit.
+     *
+     * All the entities and components are owned by the instance, so several
+     * independent worlds can coexist.
      */
     class ComponentManager {
         using Deleted = __detail::Deleted;
-        using DeletedData = __detail::DeletedData;
-        template<typename TComponent>
-        static constexpr auto entityData = __detail::entityData<TComponent>;
      public:
-        /** \brief Creates a new entity without any components. */
+        ComponentManager() = default;
+        ComponentManager(const ComponentManager&) = delete;
+        ComponentManager& operator=(const ComponentManager&) = delete;
+
+        /**
+         * \brief State of all the entities and components of a manager,
+         * captured by snapshot().
+         */
+        class Snapshot {
+         private:
+            friend class ComponentManager;
+
+            const ComponentManager* owner = nullptr;
+            std::array<std::shared_ptr<const __detail::SparseSetSnapshotBase>, maxComponentTypes> storages;
+            __detail::EntityRegistry registry;
+            std::vector<size_t> groupSizes;
+            size_t numDeletedEntities = 0;
+        };
+
+        /**
+         * \brief Creates a new entity without any components, reusing the
+         * index of a destroyed entity if there is one.
+         */
         Entity createEntity();
+        /**
+         * \brief Checks if a handle refers to a live entity, i.e if it was
+         * returned by createEntity() and the entity wasn't destroyed since.
+         */
+        bool isValid(Entity) const;
         /**
          * \brief Deletes an entity, making it invisible to forEachEntity().
          * Note that the bindings between the entity and its components are NOT
@@ -57,13 +105,41 @@ namespace engine::entitysystem {
          */
         void restoreEntity(Entity);
         /**
-         * \brief Removes the bindings between all deleted entities and their
-         * components, effectively removing them from the system. Note that
-         * deleted entities can be "brought back to life" by having components
-         * added to them as usual.
+         * \brief Removes the bindings between all deleted entities and the
+         * input components. Deleted entities that are left without any
+         * components are destroyed: their handles become invalid and their
+         * indexes are recycled. The others can still be "brought back to
+         * life" by having components added to them as usual.
          */
         template<typename T, typename... Ts>
         void cleanup();
+        /**
+         * \brief Destroys all deleted entities, removing their components of
+         * every type and recycling their indexes, then releases the storage
+         * pages left empty. Returns the number of bytes reclaimed from the
+         * component storages.
+         */
+        size_t cleanup();
+
+        /**
+         * \brief Captures the state of all entities and components, so that
+         * it can be brought back by restore(). The component pages are shared
+         * with the snapshot and only copied right before they're written, so
+         * taking a snapshot costs about as much as copying the entity handles.
+         *
+         * Writes are detected through the methods of this class: references
+         * to components obtained before the snapshot must not be used to
+         * modify them afterwards. Throws std::logic_error if a component type
+         * is not copyable.
+         */
+        Snapshot snapshot();
+        /**
+         * \brief Brings back the state captured by snapshot(). Only the pages
+         * written since then are copied back, in place, and their components
+         * are marked as changed. Throws std::logic_error if the snapshot was
+         * taken by another manager or if groups were created since then.
+         */
+        void restore(const Snapshot&);
 
         /**
          * \brief Removes the bindings between every entity and the input components.
@@ -79,7 +155,22 @@ namespace engine::entitysystem {
         void reserve(size_t count);
 
         /**
-         * \brief Adds a default-initialized T component to an entity.
+         * \brief Groups the input components, so that
+         * `forEachEntity<T, Ts...>()` becomes a linear walk over the matching
+         * entities instead of looking up every Ts component of every T entity.
+         *
+         * The entities that have all the input components are kept packed at
+         * the front of each component storage, in the same order. Each
+         * component can only be owned by a single group: calling this method
+         * again with the same components does nothing, but calling it with a
+         * component owned by a different group throws std::logic_error.
+         */
+        template<typename T, typename... Ts>
+        void group();
+
+        /**
+         * \brief Adds a default-initialized T component to an entity. Adding
+         * a component to an invalid entity throws std::invalid_argument.
          */
         template<typename T>
         void addComponent(Entity);
@@ -105,11 +196,49 @@ namespace engine::entitysystem {
         bool hasAllComponents(Entity) const;
 
         /**
-         * \brief Returns the T component data of an entity. Throws if
-         * the entity doesn't have the T component.
+         * \brief Returns the T component data of an entity, marking it as
+         * changed. Throws if the entity doesn't have the T component.
          */
         template<typename T>
         T& getData(Entity);
+        /**
+         * \brief Returns the T component data of an entity without marking
+         * it as changed. Throws if the entity doesn't have the T component.
+         */
+        template<typename T>
+        const T& getData(Entity) const;
+
+        /**
+         * \brief Returns the current change tick. Components added or
+         * accessed mutably are stamped with it.
+         */
+        Tick currentTick() const;
+        /**
+         * \brief Ends the current change tick, returning it. Changes made
+         * from now on are stamped with a greater tick, so passing the returned
+         * tick to hasChangedSince() or forEachChanged() later on reports
+         * exactly the changes made in between.
+         */
+        Tick advanceTick();
+        /**
+         * \brief Marks the T component of an entity as changed.
+         */
+        template<typename T>
+        void markChanged(Entity);
+        /**
+         * \brief Checks if the T component of an entity was added or
+         * accessed mutably after a given tick.
+         */
+        template<typename T>
+        bool hasChangedSince(Entity, Tick) const;
+        /**
+         * \brief Iterates over the entities whose T component was added or
+         * accessed mutably after a given tick, passing the entity and a
+         * `const T&` to the callback. Returns the tick to use in the next
+         * call to only visit the changes made after this one.
+         */
+        template<typename T, typename Functor>
+        Tick forEachChanged(Tick sinceTick, Functor fn);
 
         /**
          * \brief Iterates over all entities that have all the input components,
@@ -121,22 +250,133 @@ namespace engine::entitysystem {
          *
          * `std::function<void(Entity, T&, std::add_lvalue_reference_t<Ts>...)> fn`
          *
+         * Components can be declared as read-only (`const T`), in which case
+         * `fn` receives a `const T&`. The others are marked as changed for
+         * every visited entity.
+         *
+         * The callback may remove the T component of the entity it receives.
+         * Any other structural change (creating or deleting entities, adding
+         * or removing components) may move the data being iterated, so it
+         * should be recorded in a CommandBuffer and played back afterwards.
+         *
          * **Note**: the performance of this method increases if the least common
          * components come first in the list, especially the first.
          */
         template<typename T, typename... Ts, typename Functor>
         void forEachEntity(Functor fn);
 
+        /**
+         * \brief Returns a persistent query over the entities that have all
+         * the input components. The matching entities are cached and kept up
+         * to date as components are added and removed, so iterating over a
+         * query doesn't scan any non-matching entity. Queries with the same
+         * set of components share their cache, which is built on first use.
+         * Requires Query.hpp.
+         */
+        template<typename T, typename... Ts>
+        Query<T, Ts...> query();
+        /**
+         * \brief Returns the signature and statistics of every cached query.
+         */
+        std::vector<std::pair<Signature, QueryStats>> queryStats() const;
+        /**
+         * \brief Returns the occupancy and memory usage of every component
+         * type used by this manager, along with the number of additions and
+         * removals since the last resetStats(). Scans all entities.
+         */
+        ManagerStats stats() const;
+        /**
+         * \brief Resets the addition and removal counters of stats().
+         */
+        void resetStats();
+
+        /**
+         * \brief Default number of entities processed by each parallel task.
+         */
+        static constexpr size_t defaultGrainSize = 4096;
+
+        /**
+         * \brief Sets the thread pool used by parallelForEachEntity(). If no
+         * pool is set, parallel iterations run on the calling thread.
+         */
+        void setThreadPool(utils::ThreadPool*);
+
+        /**
+         * \brief Like forEachEntity(), but splits the matching entities into
+         * chunks of `grainSize` entities that are processed by the thread
+         * pool in parallel.
+         *
+         * Each component must be declared either as read-only (`const T`),
+         * in which case `fn` receives a `const T&`, or as writable (`T`).
+         * Throws std::logic_error if a writable component is accessed by
+         * another active parallel iteration, or if a read-only one is being
+         * written by one.
+         *
+         * `fn` is called concurrently and must not add or remove components
+         * directly, nor write to anything shared without synchronization.
+         * Structural changes can be recorded in a CommandBuffer instead.
+         */
+        template<typename T, typename... Ts, typename Functor>
+        void parallelForEachEntity(Functor fn, size_t grainSize = defaultGrainSize);
+
      private:
+        template<typename T, typename... Ts>
+        friend class Query;
+
+        std::array<std::unique_ptr<__detail::SparseSetBase>, maxComponentTypes> storages;
+        // Declared after the storages, so that groups are destroyed first
+        std::vector<std::unique_ptr<__detail::GroupBase>> groups;
+        std::vector<std::unique_ptr<__detail::QueryCache>> queries;
+        __detail::EntityRegistry registry;
+        __detail::AccessStates accessStates{};
+        Tick changeTick = 1;
         size_t numDeletedEntities = 0;
+        std::array<size_t, maxComponentTypes> numAdditions{};
+        std::array<size_t, maxComponentTypes> numRemovals{};
+        utils::ThreadPool* threadPool = nullptr;
+
+        template<typename T>
+        SparseSet<T>& entityData();
+        template<typename T>
+        const SparseSet<T>* findEntityData() const;
+        template<typename T>
+        T& accessData(SparseSet<std::remove_const_t<T>>&, size_t index);
+        template<typename T>
+        T& accessData(Entity);
+
+        template<typename T, typename... Ts>
+        bool isGroup() const;
+        template<typename T, typename... Ts>
+        void unshare();
+
+        Signature signature(Entity) const;
+        Signature& mutableSignature(Entity);
+        void updateSignature(Entity, size_t componentId, bool value);
+        void notifyQueries(Entity, const Signature& before, const Signature& after);
+        bool isVisible(Entity, const Signature& required) const;
+        void destroyEntity(Entity);
+        size_t memoryUsage() const;
 
         template<typename T, typename... Ts>
-        void cleanupHelper(DeletedData&);
+        void cleanupHelper(Entity);
     };
 
     inline Entity ComponentManager::createEntity() {
-        static Entity nextEntity = 0;
-        return nextEntity++;
+        if (!registry.freeIndices.empty()) {
+            Entity::Index index = registry.freeIndices.back();
+            registry.freeIndices.pop_back();
+            return {index, registry.versions[index]};
+        }
+
+        Entity::Index index = registry.versions.size();
+        registry.versions.push_back(1);
+        registry.signatures.emplace_back();
+        return {index, 1};
+    }
+
+    inline bool ComponentManager::isValid(Entity entity) const {
+        return entity.index < registry.versions.size()
+            && registry.versions[entity.index] == entity.version;
     }
 
     inline void ComponentManager::deleteEntity(Entity entity) {
@@ -154,15 +394,119 @@ namespace engine::entitysystem {
 
     template<typename T, typename... Ts>
     inline void ComponentManager::cleanup() {
-        DeletedData& deletedData = __detail::entityData<Deleted>();
-        cleanupHelper<T, Ts...>(deletedData);
-        deletedData.clear();
+        size_t deletedId = componentId<Deleted>();
+
+        for (Entity::Index index = 0; index < registry.signatures.size(); ++index) {
+            if (registry.signatures[index].test(deletedId)) {
+                Entity entity{index, registry.versions[index]};
+                cleanupHelper<T, Ts...>(entity);
+                updateSignature(entity, deletedId, false);
+
+                if (registry.signatures[index].none()) {
+                    destroyEntity(entity);
+                }
+            }
+        }
+
+        numDeletedEntities = 0;
+    }
+
+    inline size_t ComponentManager::cleanup() {
+        size_t deletedId = componentId<Deleted>();
+        size_t usageBefore = memoryUsage();
+
+        for (Entity::Index index = 0; index < registry.signatures.size(); ++index) {
+            const Signature& signature = registry.signatures[index];
+
+            if (!signature.test(deletedId)) {
+                continue;
+            }
+
+            Entity entity{index, registry.versions[index]};
+
+            for (size_t id = 0; id < maxComponentTypes; ++id) {
+                if (signature.test(id) && storages[id]) {
+                    storages[id]->erase(entity);
+                }
+            }
+
+            destroyEntity(entity);
+        }
+
+        for (auto& storage : storages) {
+            if (storage) {
+                storage->shrinkToFit();
+            }
+        }
+
         numDeletedEntities = 0;
+        return usageBefore - memoryUsage();
+    }
+
+    inline ComponentManager::Snapshot ComponentManager::snapshot() {
+        Snapshot result;
+        result.owner = this;
+
+        for (size_t id = 0; id < maxComponentTypes; ++id) {
+            if (storages[id]) {
+                result.storages[id] = storages[id]->snapshot();
+            }
+        }
+
+        result.registry = registry;
+        result.numDeletedEntities = numDeletedEntities;
+
+        for (auto& group : groups) {
+            result.groupSizes.push_back(group->size());
+        }
+
+        return result;
+    }
+
+    inline void ComponentManager::restore(const Snapshot& snapshot) {
+        if (snapshot.owner != this) {
+            throw std::logic_error("ComponentManager::restore: snapshot taken by another manager");
+        }
+
+        if (snapshot.groupSizes.size() != groups.size()) {
+            throw std::logic_error("ComponentManager::restore: groups were created after the snapshot");
+        }
+
+        for (size_t id = 0; id < maxComponentTypes; ++id) {
+            if (storages[id]) {
+                storages[id]->restore(snapshot.storages[id].get(), changeTick);
+            }
+        }
+
+        for (size_t i = 0; i < groups.size(); ++i) {
+            groups[i]->onRestore(snapshot.groupSizes[i]);
+        }
+
+        registry = snapshot.registry;
+        numDeletedEntities = snapshot.numDeletedEntities;
+
+        for (auto& query : queries) {
+            query->build(registry.signatures, registry.versions);
+        }
     }
 
     template <typename T, typename... Ts>
     void ComponentManager::clearAll() {
-        entityData<T>().clear();
+        size_t id = componentId<T>();
+
+        if constexpr (isTagComponent<T>) {
+            for (Entity::Index index = 0; index < registry.signatures.size(); ++index) {
+                updateSignature({index, registry.versions[index]}, id, false);
+            }
+        } else {
+            auto& allEntitiesData = entityData<T>();
+
+            for (size_t i = 0; i < allEntitiesData.size(); ++i) {
+                updateSignature(allEntitiesData.entityAt(i), id, false);
+            }
+
+            allEntitiesData.clear();
+        }
 
         if constexpr (sizeof...(Ts) > 0) {
             clearAll<Ts...>();
@@ -171,90 +515,469 @@ namespace engine::entitysystem {
 
     template<typename T>
     void ComponentManager::reserve(size_t count) {
-        entityData<T>().reserve(count);
+        if constexpr (!isTagComponent<T>) {
+            entityData<T>().reserve(count);
+        }
+    }
+
+    template<typename T, typename... Ts>
+    void ComponentManager::group() {
+        static_assert(sizeof...(Ts) > 0, "A group needs at least two components");
+        static_assert(
+            !isTagComponent<T> && (!isTagComponent<Ts> && ...),
+            "Tag components cannot be grouped"
+        );
+
+        if (isGroup<T, Ts...>()) {
+            return;
+        }
+
+        if (entityData<T>().getGroup() || (entityData<Ts>().getGroup() || ...)) {
+            throw std::logic_error("A component can only be owned by a single group");
+        }
+
+        auto group = new OwningGroup<T, Ts...>(entityData<T>(), entityData<Ts>()...);
+        groups.emplace_back(group);
+        entityData<T>().setGroup(group);
+        (entityData<Ts>().setGroup(group), ...);
     }
 
     template<typename T>
     inline void ComponentManager::addComponent(Entity entity) {
-        entityData<T>().insert({entity, T()});
+        if constexpr (!isTagComponent<T>) {
+            if (entityData<T>().emplace(entity)) {
+                markChanged<T>(entity);
+            }
+        }
+
+        updateSignature(entity, componentId<T>(), true);
     }
 
     template<typename T>
     inline void ComponentManager::addComponent(Entity entity, T&& data) {
-        entityData<std::decay_t<T>>().insert({
-            entity,
-            std::forward<T>(data)
-        });
+        using TComponent = std::decay_t<T>;
+
+        if constexpr (!isTagComponent<TComponent>) {
+            if (entityData<TComponent>().emplace(entity, std::forward<T>(data))) {
+                markChanged<TComponent>(entity);
+            }
+        }
+
+        updateSignature(entity, componentId<TComponent>(), true);
     }
 
     template<typename T>
     inline void ComponentManager::removeComponent(Entity entity) {
-        entityData<T>().erase(entity);
+        if (!hasComponent<T>(entity)) {
+            return;
+        }
+
+        if constexpr (!isTagComponent<T>) {
+            entityData<T>().erase(entity);
+        }
+
+        updateSignature(entity, componentId<T>(), false);
     }
 
     template<typename T>
     inline bool ComponentManager::hasComponent(Entity entity) const {
-        return entityData<T>().count(entity);
+        return signature(entity).test(componentId<T>());
     }
 
     template<typename T, typename... Ts>
     bool ComponentManager::hasAllComponents(Entity entity) const {
-        bool hasT = hasComponent<T>(entity);
+        const Signature& required = signatureOf<T, Ts...>();
+        return (signature(entity) & required) == required;
+    }
 
-        if constexpr (sizeof...(Ts) > 0) {
-            return hasT && hasAllComponents<Ts...>(entity);
+    template<typename T>
+    inline T& ComponentManager::getData(Entity entity) {
+        if constexpr (isTagComponent<T>) {
+            if (!hasComponent<T>(entity)) {
+                throw std::out_of_range("ComponentManager::getData: entity has no such component");
+            }
+
+            return __detail::tagInstance<T>();
         } else {
-            return hasT;
+            T& data = entityData<T>().get(entity);
+            markChanged<T>(entity);
+            return data;
         }
     }
 
     template<typename T>
-    inline T& ComponentManager::getData(Entity entity) {
-        return entityData<T>().at(entity);
+    inline const T& ComponentManager::getData(Entity entity) const {
+        if constexpr (isTagComponent<T>) {
+            if (!hasComponent<T>(entity)) {
+                throw std::out_of_range("ComponentManager::getData: entity has no such component");
+            }
+
+            return __detail::tagInstance<T>();
+        } else {
+            auto storage = findEntityData<T>();
+
+            if (!storage) {
+                throw std::out_of_range("ComponentManager::getData: entity has no such component");
+            }
+
+            return storage->get(entity);
+        }
+    }
+
+    inline Tick ComponentManager::currentTick() const {
+        return changeTick;
+    }
+
+    inline Tick ComponentManager::advanceTick() {
+        return changeTick++;
+    }
+
+    template<typename T>
+    inline void ComponentManager::markChanged(Entity entity) {
+        if constexpr (!isTagComponent<T>) {
+            auto& storage = entityData<T>();
+            size_t index = storage.indexOf(entity);
+
+            if (index < storage.size()) {
+                storage.changeTickAt(index) = changeTick;
+            }
+        }
+    }
+
+    template<typename T>
+    inline bool ComponentManager::hasChangedSince(Entity entity, Tick tick) const {
+        static_assert(!isTagComponent<T>, "Tag components have no change tracking");
+        auto storage = findEntityData<T>();
+        size_t index = storage ? storage->indexOf(entity) : 0;
+        return storage && index < storage->size() && storage->changeTickAt(index) > tick;
+    }
+
+    template<typename T, typename Functor>
+    inline Tick ComponentManager::forEachChanged(Tick sinceTick, Functor fn) {
+        static_assert(!isTagComponent<T>, "Tag components have no change tracking");
+        const Signature& required = signatureOf<T>();
+        auto& allEntitiesData = entityData<T>();
+        Tick seenTick = advanceTick();
+
+        for (size_t i = allEntitiesData.size(); i > 0; i = std::min(i - 1, allEntitiesData.size())) {
+            Entity entity = allEntitiesData.entityAt(i - 1);
+
+            if (allEntitiesData.changeTickAt(i - 1) > sinceTick && isVisible(entity, required)) {
+                fn(entity, std::as_const(allEntitiesData).dataAt(i - 1));
+            }
+        }
+
+        return seenTick;
     }
 
     template<typename T, typename... Ts, typename Functor>
     inline void ComponentManager::forEachEntity(Functor fn) {
-        auto& allEntitiesData = entityData<T>();
+        using TData = std::remove_const_t<T>;
+        const Signature& required = signatureOf<TData, std::remove_const_t<Ts>...>();
 
-        if constexpr (sizeof...(Ts) > 0) {
-            if (numDeletedEntities > 0) {
-                for (auto& [entity, data] : allEntitiesData) {
-                    if (!hasComponent<Deleted>(entity) && hasAllComponents<Ts...>(entity)) {
-                        fn(entity, data, getData<Ts>(entity)...);
-                    }
-                }
-            } else {
-                for (auto& [entity, data] : allEntitiesData) {
-                    if (hasAllComponents<Ts...>(entity)) {
-                        fn(entity, data, getData<Ts>(entity)...);
-                    }
+        if constexpr (isTagComponent<TData>) {
+            for (size_t i = registry.signatures.size(); i > 0; --i) {
+                Entity entity{static_cast<Entity::Index>(i - 1), registry.versions[i - 1]};
+
+                if (isVisible(entity, required)) {
+                    fn(entity, accessData<T>(entity), accessData<Ts>(entity)...);
                 }
             }
+
+            return;
         } else {
-            if (numDeletedEntities > 0) {
-                for (auto& [entity, data] : allEntitiesData) {
-                    if (!hasComponent<Deleted>(entity)) {
-                        fn(entity, data);
+            auto& allEntitiesData = entityData<TData>();
+
+            if constexpr (!(isTagComponent<std::remove_const_t<Ts>> || ...)) {
+                if (isGroup<TData, std::remove_const_t<Ts>...>()) {
+                    auto& group = *allEntitiesData.getGroup();
+
+                    for (size_t i = group.size(); i > 0; i = std::min(i - 1, group.size())) {
+                        Entity entity = allEntitiesData.entityAt(i - 1);
+
+                        if (numDeletedEntities > 0 && hasComponent<Deleted>(entity)) {
+                            continue;
+                        }
+
+                        fn(
+                            entity,
+                            accessData<T>(allEntitiesData, i - 1),
+                            accessData<Ts>(entityData<std::remove_const_t<Ts>>(), i - 1)...
+                        );
                     }
+
+                    return;
                 }
-            } else {
-                for (auto& [entity, data] : allEntitiesData) {
-                    fn(entity, data);
+            }
+
+            // Iterates backwards so that removing the current entity's T component
+            // only moves already visited data into the current position
+            for (size_t i = allEntitiesData.size(); i > 0; i = std::min(i - 1, allEntitiesData.size())) {
+                Entity entity = allEntitiesData.entityAt(i - 1);
+
+                if (isVisible(entity, required)) {
+                    fn(entity, accessData<T>(allEntitiesData, i - 1), accessData<Ts>(entity)...);
                 }
             }
         }
     }
 
+    inline void ComponentManager::setThreadPool(utils::ThreadPool* pool) {
+        threadPool = pool;
+    }
+
+    template<typename T, typename... Ts, typename Functor>
+    inline void ComponentManager::parallelForEachEntity(Functor fn, size_t grainSize) {
+        static_assert(
+            !isTagComponent<std::remove_const_t<T>>,
+            "The first component of a parallel iteration must hold data"
+        );
+        ComponentAccess<T, Ts...> access(accessStates);
+        unshare<T, Ts...>();
+        const Signature& required = signatureOf<std::remove_const_t<T>, std::remove_const_t<Ts>...>();
+        auto& allEntitiesData = entityData<std::remove_const_t<T>>();
+        bool grouped = false;
+
+        if constexpr (sizeof...(Ts) > 0) {
+            grouped = isGroup<std::remove_const_t<T>, std::remove_const_t<Ts>...>();
+        }
+
+        auto processRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Entity entity = allEntitiesData.entityAt(i);
+
+                if (!isVisible(entity, required)) {
+                    continue;
+                }
+
+                if constexpr (sizeof...(Ts) == 0) {
+                    fn(entity, accessData<T>(allEntitiesData, i));
+                } else if (grouped) {
+                    if constexpr (!(isTagComponent<std::remove_const_t<Ts>> || ...)) {
+                        fn(
+                            entity,
+                            accessData<T>(allEntitiesData, i),
+                            accessData<Ts>(entityData<std::remove_const_t<Ts>>(), i)...
+                        );
+                    }
+                } else {
+                    fn(entity, accessData<T>(allEntitiesData, i), accessData<Ts>(entity)...);
+                }
+            }
+        };
+
+        size_t count = grouped ? allEntitiesData.getGroup()->size() : allEntitiesData.size();
+
+        if (threadPool) {
+            threadPool->parallelFor(count, grainSize, processRange);
+        } else {
+            processRange(0, count);
+        }
+    }
 
     template<typename T, typename... Ts>
-    inline void ComponentManager::cleanupHelper(DeletedData& deletedData) {
-        for (const auto& [entity, _] : deletedData) {
-            entityData<T>().erase(entity);
+    inline bool ComponentManager::isGroup() const {
+        if constexpr (sizeof...(Ts) == 0 || isTagComponent<T> || (isTagComponent<Ts> || ...)) {
+            return false;
+        } else {
+            auto storage = findEntityData<T>();
+            auto group = storage ? storage->getGroup() : nullptr;
+
+            return group
+                && group->typeCount() == 1 + sizeof...(Ts)
+                && ((findEntityData<Ts>() && findEntityData<Ts>()->getGroup() == group) && ...);
         }
+    }
+
+    template<typename T, typename... Ts>
+    inline void ComponentManager::unshare() {
+        if constexpr (!std::is_const_v<T> && !isTagComponent<T>) {
+            entityData<T>().unshare();
+        }
+
+        if constexpr (sizeof...(Ts) > 0) {
+            unshare<Ts...>();
+        }
+    }
+
+    inline Signature ComponentManager::signature(Entity entity) const {
+        return isValid(entity) ? registry.signatures[entity.index] : Signature();
+    }
+
+    inline Signature& ComponentManager::mutableSignature(Entity entity) {
+        if (!isValid(entity)) {
+            throw std::invalid_argument("ComponentManager: invalid entity");
+        }
+
+        return registry.signatures[entity.index];
+    }
+
+    inline void ComponentManager::updateSignature(Entity entity, size_t componentId, bool value) {
+        Signature& signature = mutableSignature(entity);
+
+        if (signature.test(componentId) == value) {
+            return;
+        }
+
+        Signature before = signature;
+        signature.set(componentId, value);
+        ++(value ? numAdditions : numRemovals)[componentId];
+        notifyQueries(entity, before, signature);
+    }
+
+    inline void ComponentManager::notifyQueries(
+        Entity entity,
+        const Signature& before,
+        const Signature& after
+    ) {
+        for (auto& query : queries) {
+            query->onSignatureChanged(entity, before, after);
+        }
+    }
+
+    inline std::vector<std::pair<Signature, QueryStats>> ComponentManager::queryStats() const {
+        std::vector<std::pair<Signature, QueryStats>> result;
+
+        for (auto& query : queries) {
+            result.emplace_back(query->signature(), query->stats());
+        }
+
+        return result;
+    }
+
+    inline ManagerStats ComponentManager::stats() const {
+        size_t deletedId = componentId<Deleted>();
+        std::array<size_t, maxComponentTypes> counts{};
+        std::array<size_t, maxComponentTypes> deletedCounts{};
+        ManagerStats result;
+        result.tick = changeTick;
+        result.entitySlots = registry.signatures.size();
+        result.freeEntitySlots = registry.freeIndices.size();
+        result.bytes = memoryUsage();
+
+        for (auto& signature : registry.signatures) {
+            bool deleted = signature.test(deletedId);
+            result.deletedEntities += deleted;
+
+            for (size_t id = 0; id < maxComponentTypes; ++id) {
+                counts[id] += signature.test(id);
+                deletedCounts[id] += deleted && signature.test(id);
+            }
+        }
+
+        for (size_t id = 0; id < maxComponentTypes; ++id) {
+            auto& storage = storages[id];
+
+            if (!storage && counts[id] == 0 && numAdditions[id] == 0) {
+                continue;
+            }
+
+            ComponentStats component;
+            component.id = id;
+            component.name = id == deletedId ? "Deleted" : componentName(id);
+            component.isTag = !storage;
+            component.count = storage ? storage->size() : counts[id];
+            component.capacity = storage ? storage->capacity() : 0;
+            component.bytes = storage ? storage->memoryUsage() : 0;
+            component.fillRatio = component.capacity > 0
+                ? static_cast<double>(component.count) / component.capacity
+                : 0;
+            component.deletedCount = deletedCounts[id];
+            component.additions = numAdditions[id];
+            component.removals = numRemovals[id];
+            result.components.push_back(std::move(component));
+        }
+
+        return result;
+    }
+
+    inline void ComponentManager::resetStats() {
+        numAdditions.fill(0);
+        numRemovals.fill(0);
+    }
+
+    inline bool ComponentManager::isVisible(Entity entity, const Signature& required) const {
+        static const Signature& deleted = signatureOf<Deleted>();
+        const Signature& mask = numDeletedEntities > 0 ? (required | deleted) : required;
+        return (signature(entity) & mask) == required;
+    }
+
+    template<typename T>
+    inline SparseSet<T>& ComponentManager::entityData() {
+        static_assert(!isTagComponent<T>, "Tag components have no storage");
+        auto& storage = storages[componentId<T>()];
+
+        if (!storage) {
+            storage.reset(new SparseSet<T>());
+        }
+
+        return static_cast<SparseSet<T>&>(*storage);
+    }
+
+    template<typename T>
+    inline const SparseSet<T>* ComponentManager::findEntityData() const {
+        return static_cast<const SparseSet<T>*>(storages[componentId<T>()].get());
+    }
+
+    template<typename T>
+    inline T& ComponentManager::accessData(SparseSet<std::remove_const_t<T>>& storage, size_t index) {
+        if constexpr (std::is_const_v<T>) {
+            return std::as_const(storage).dataAt(index);
+        } else {
+            storage.changeTickAt(index) = changeTick;
+            return storage.dataAt(index);
+        }
+    }
+
+    template<typename T>
+    inline T& ComponentManager::accessData(Entity entity) {
+        using TData = std::remove_const_t<T>;
+
+        if constexpr (isTagComponent<TData>) {
+            return __detail::tagInstance<TData>();
+        } else {
+            auto& storage = entityData<TData>();
+            return accessData<T>(storage, storage.indexOf(entity));
+        }
+    }
+
+    inline void ComponentManager::destroyEntity(Entity entity) {
+        Entity::Version& version = registry.versions[entity.index];
+
+        // Version 0 is reserved for handles that never refer to an entity
+        if (++version == 0) {
+            version = 1;
+        }
+
+        Signature before = registry.signatures[entity.index];
+        registry.signatures[entity.index].reset();
+
+        for (size_t id = 0; id < maxComponentTypes; ++id) {
+            numRemovals[id] += before.test(id);
+        }
+
+        notifyQueries(entity, before, Signature());
+        registry.freeIndices.push_back(entity.index);
+    }
+
+    inline size_t ComponentManager::memoryUsage() const {
+        size_t result = 0;
+
+        for (auto& storage : storages) {
+            if (storage) {
+                result += storage->memoryUsage();
+            }
+        }
+
+        return result;
+    }
+
+    template<typename T, typename... Ts>
+    inline void ComponentManager::cleanupHelper(Entity entity) {
+        removeComponent<T>(entity);
 
         if constexpr (sizeof...(Ts) > 0) {
-            cleanupHelper<Ts...>(deletedData);
+            cleanupHelper<Ts...>(entity);
         }
     }
 }
@@ -0,0 +1,127 @@
+#ifndef ENTITY_SYSTEM_COMPONENT_STATS_HPP
+#define ENTITY_SYSTEM_COMPONENT_STATS_HPP
+
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "types.hpp"
+
+namespace engine::entitysystem {
+    /**
+     * \brief Occupancy and usage counters of the storage of a component type.
+     */
+    struct ComponentStats {
+        size_t id = 0;
+        std::string name;
+        // Tag components have no storage, only a signature bit
+        bool isTag = false;
+        // Number of entities that have the component, deleted ones included
+        size_t count = 0;
+        // Number of components that fit in the allocated pages
+        size_t capacity = 0;
+        // Bytes allocated by the storage, not counting memory owned by the
+        // components themselves
+        size_t bytes = 0;
+        // count / capacity, or 0 if nothing is allocated
+        double fillRatio = 0;
+        // Number of components bound to deleted entities, i.e reclaimable
+        // by ComponentManager::cleanup()
+        size_t deletedCount = 0;
+        // Number of components added and removed since the last
+        // ComponentManager::resetStats()
+        size_t additions = 0;
+        size_t removals = 0;
+    };
+
+    /**
+     * \brief Snapshot of the occupancy of a ComponentManager, returned by
+     * ComponentManager::stats().
+     */
+    struct ManagerStats {
+        Tick tick = 0;
+        // Number of entity slots, including the ones that are free for reuse
+        size_t entitySlots = 0;
+        size_t freeEntitySlots = 0;
+        size_t deletedEntities = 0;
+        // Bytes allocated by all component storages
+        size_t bytes = 0;
+        std::vector<ComponentStats> components;
+    };
+
+    inline std::ostream& operator<<(std::ostream& stream, const ManagerStats& stats) {
+        std::ostringstream ss;
+        ss << "[ECS] tick " << stats.tick << ": "
+           << stats.entitySlots - stats.freeEntitySlots << " entities, "
+           << stats.freeEntitySlots << " free slots, "
+           << stats.deletedEntities << " deleted, "
+           << stats.bytes << " bytes\n";
+        ss << std::left << std::setw(4) << "id" << std::setw(32) << "component" << std::right
+           << std::setw(9) << "count" << std::setw(10) << "capacity"
+           << std::setw(11) << "bytes" << std::setw(7) << "fill"
+           << std::setw(9) << "deleted" << std::setw(9) << "added"
+           << std::setw(9) << "removed";
+
+        for (auto& component : stats.components) {
+            ss << '\n' << std::left << std::setw(4) << component.id
+               << std::setw(32) << (component.name + (component.isTag ? " (tag)" : ""))
+               << std::right << std::setw(9) << component.count
+               << std::setw(10) << component.capacity
+               << std::setw(11) << component.bytes
+               << std::setw(7) << std::fixed << std::setprecision(2) << component.fillRatio
+               << std::setw(9) << component.deletedCount
+               << std::setw(9) << component.additions
+               << std::setw(9) << component.removals;
+        }
+
+        return stream << ss.str();
+    }
+
+    /**
+     * \brief Serializes stats as a single-line JSON object.
+     */
+    inline std::string toJSON(const ManagerStats& stats) {
+        auto quote = [](const std::string& text) {
+            std::string result = "\"";
+
+            for (char ch : text) {
+                if (ch == '"' || ch == '\\') {
+                    result += '\\';
+                }
+
+                result += ch;
+            }
+
+            return result + '"';
+        };
+
+        std::ostringstream ss;
+        ss << "{\"tick\":" << stats.tick
+           << ",\"entitySlots\":" << stats.entitySlots
+           << ",\"freeEntitySlots\":" << stats.freeEntitySlots
+           << ",\"deletedEntities\":" << stats.deletedEntities
+           << ",\"bytes\":" << stats.bytes
+           << ",\"components\":[";
+
+        for (size_t i = 0; i < stats.components.size(); ++i) {
+            auto& component = stats.components[i];
+            ss << (i > 0 ? "," : "")
+               << "{\"id\":" << component.id
+               << ",\"name\":" << quote(component.name)
+               << ",\"tag\":" << (component.isTag ? "true" : "false")
+               << ",\"count\":" << component.count
+               << ",\"capacity\":" << component.capacity
+               << ",\"bytes\":" << component.bytes
+               << ",\"fillRatio\":" << component.fillRatio
+               << ",\"deleted\":" << component.deletedCount
+               << ",\"additions\":" << component.additions
+               << ",\"removals\":" << component.removals << "}";
+        }
+
+        ss << "]}";
+        return ss.str();
+    }
+}
+
+#endif
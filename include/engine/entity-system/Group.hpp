@@ -0,0 +1,139 @@
+#ifndef ENTITY_SYSTEM_GROUP_HPP
+#define ENTITY_SYSTEM_GROUP_HPP
+
+#include <tuple>
+#include "types.hpp"
+
+namespace engine::entitysystem {
+    template<typename T>
+    class SparseSet;
+
+    namespace __detail {
+        /**
+         * \brief Type-erased interface through which a SparseSet notifies the
+         * group that owns it about insertions and removals.
+         */
+        class GroupBase {
+         public:
+            virtual ~GroupBase() = default;
+
+            /**
+             * \brief Called after a component is added to an owned set.
+             */
+            virtual void onInsert(Entity) = 0;
+            /**
+             * \brief Called before a component is removed from an owned set.
+             */
+            virtual void onErase(Entity) = 0;
+            /**
+             * \brief Returns the number of component types owned by this group.
+             */
+            virtual size_t typeCount() const = 0;
+
+            /**
+             * \brief Called when an owned set is cleared.
+             */
+            void onClear() {
+                length = 0;
+            }
+            /**
+             * \brief Called when the owned sets are restored from a snapshot
+             * taken when the group had `size` entities.
+             */
+            void onRestore(size_t size) {
+                length = size;
+            }
+
+            /**
+             * \brief Returns the number of entities that have all the owned
+             * components.
+             */
+            size_t size() const {
+                return length;
+            }
+
+         protected:
+            size_t length = 0;
+        };
+    }
+
+    /**
+     * \brief Keeps the entities that have all the Ts components packed at
+     * the front of each Ts storage, in the same order.
+     *
+     * The first size() dense positions of every owned SparseSet refer to the
+     * same entities, so a query over exactly the owned components is a
+     * linear walk over parallel arrays, with no lookups at all.
+     */
+    template<typename... Ts>
+    class OwningGroup : public __detail::GroupBase {
+     public:
+        explicit OwningGroup(SparseSet<Ts>&...);
+
+        void onInsert(Entity) override;
+        void onErase(Entity) override;
+        size_t typeCount() const override;
+
+     private:
+        std::tuple<SparseSet<Ts>&...> sets;
+
+        bool hasAllComponents(Entity) const;
+        bool isGrouped(Entity) const;
+        void moveTo(Entity, size_t position);
+    };
+
+    template<typename... Ts>
+    inline OwningGroup<Ts...>::OwningGroup(SparseSet<Ts>&... sets) : sets(sets...) {
+        auto& first = std::get<0>(this->sets);
+
+        for (size_t i = 0; i < first.size(); ++i) {
+            Entity entity = first.entityAt(i);
+
+            if (hasAllComponents(entity)) {
+                moveTo(entity, length);
+                ++length;
+            }
+        }
+    }
+
+    template<typename... Ts>
+    inline void OwningGroup<Ts...>::onInsert(Entity entity) {
+        if (hasAllComponents(entity)) {
+            moveTo(entity, length);
+            ++length;
+        }
+    }
+
+    template<typename... Ts>
+    inline void OwningGroup<Ts...>::onErase(Entity entity) {
+        if (isGrouped(entity)) {
+            --length;
+            moveTo(entity, length);
+        }
+    }
+
+    template<typename... Ts>
+    inline size_t OwningGroup<Ts...>::typeCount() const {
+        return sizeof...(Ts);
+    }
+
+    template<typename... Ts>
+    inline bool OwningGroup<Ts...>::hasAllComponents(Entity entity) const {
+        return (std::get<SparseSet<Ts>&>(sets).contains(entity) && ...);
+    }
+
+    template<typename... Ts>
+    inline bool OwningGroup<Ts...>::isGrouped(Entity entity) const {
+        return std::get<0>(sets).indexOf(entity) < length;
+    }
+
+    template<typename... Ts>
+    inline void OwningGroup<Ts...>::moveTo(Entity entity, size_t position) {
+        (std::get<SparseSet<Ts>&>(sets).swapAt(
+            std::get<SparseSet<Ts>&>(sets).indexOf(entity),
+            position
+        ), ...);
+    }
+}
+
+#endif
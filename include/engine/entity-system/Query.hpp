@@ -0,0 +1,165 @@
+#ifndef ENTITY_SYSTEM_QUERY_HPP
+#define ENTITY_SYSTEM_QUERY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "ComponentManager.hpp"
+#include "QueryCache.hpp"
+#include "types.hpp"
+
+namespace engine::entitysystem {
+    /**
+     * \brief Handle to a cached query of a ComponentManager, created by
+     * ComponentManager::query(). Handles are cheap to copy and remain valid
+     * for as long as the manager lives.
+     */
+    template<typename T, typename... Ts>
+    class Query {
+     public:
+        Query(ComponentManager&, __detail::QueryCache&);
+
+        /**
+         * \brief Like ComponentManager::forEachEntity(), but only walks the
+         * cached list of matching entities. The same rules apply: components
+         * can be declared as read-only (`const T`), and the callback may
+         * remove the T component of the entity it receives.
+         */
+        template<typename Functor>
+        void forEach(Functor fn);
+
+        /**
+         * \brief Returns the number of matching entities.
+         */
+        size_t size() const;
+        /**
+         * \brief Returns the statistics of the underlying cache, which are
+         * shared by all the queries with the same components.
+         */
+        const QueryStats& stats() const;
+
+     private:
+        // Storage of a component type, or SparseSetBase for tags, which
+        // have none
+        template<typename U>
+        using Storage = std::conditional_t<
+            isTagComponent<std::remove_const_t<U>>,
+            __detail::SparseSetBase,
+            SparseSet<std::remove_const_t<U>>
+        >;
+
+        ComponentManager* manager;
+        __detail::QueryCache* cache;
+
+        template<typename Functor, size_t... Is>
+        void forEach(Functor&, std::index_sequence<Is...>);
+        template<typename U>
+        Storage<U>* storage();
+        template<typename U>
+        U& accessData(Storage<U>*, size_t index);
+        static uint64_t layoutVersion(const __detail::SparseSetBase*);
+    };
+
+    template<typename T, typename... Ts>
+    inline Query<T, Ts...>::Query(ComponentManager& manager, __detail::QueryCache& cache)
+     : manager(&manager), cache(&cache) { }
+
+    template<typename T, typename... Ts>
+    template<typename Functor>
+    inline void Query<T, Ts...>::forEach(Functor fn) {
+        forEach(fn, std::index_sequence_for<T, Ts...>());
+    }
+
+    template<typename T, typename... Ts>
+    template<typename Functor, size_t... Is>
+    inline void Query<T, Ts...>::forEach(Functor& fn, std::index_sequence<Is...>) {
+        using Components = std::tuple<T, Ts...>;
+        QueryStats& stats = cache->stats();
+        ++stats.iterations;
+        cache->resolve(manager->storages);
+
+        auto storages = std::make_tuple(storage<T>(), storage<Ts>()...);
+        const size_t columns[] = {
+            cache->columnOf(componentId<std::remove_const_t<T>>()),
+            cache->columnOf(componentId<std::remove_const_t<Ts>>())...
+        };
+        // The callback may only remove the T component, which moves the last
+        // T component into its dense index
+        uint64_t layout = layoutVersion(std::get<0>(storages));
+
+        for (size_t i = cache->size(); i > 0; i = std::min(i - 1, cache->size())) {
+            Entity entity = cache->entityAt(i - 1);
+            ++stats.entitiesVisited;
+
+            if (layoutVersion(std::get<0>(storages)) == layout) {
+                const size_t* denseIndexes = cache->denseIndexesAt(i - 1);
+                fn(entity, accessData<std::tuple_element_t<Is, Components>>(
+                    std::get<Is>(storages),
+                    denseIndexes[columns[Is]]
+                )...);
+            } else {
+                fn(entity, manager->accessData<T>(entity), manager->accessData<Ts>(entity)...);
+            }
+        }
+    }
+
+    template<typename T, typename... Ts>
+    template<typename U>
+    inline auto Query<T, Ts...>::storage() -> Storage<U>* {
+        if constexpr (isTagComponent<std::remove_const_t<U>>) {
+            return nullptr;
+        } else {
+            return &manager->entityData<std::remove_const_t<U>>();
+        }
+    }
+
+    template<typename T, typename... Ts>
+    template<typename U>
+    inline U& Query<T, Ts...>::accessData(Storage<U>* storage, size_t index) {
+        if constexpr (isTagComponent<std::remove_const_t<U>>) {
+            return __detail::tagInstance<std::remove_const_t<U>>();
+        } else {
+            return manager->accessData<U>(*storage, index);
+        }
+    }
+
+    template<typename T, typename... Ts>
+    inline uint64_t Query<T, Ts...>::layoutVersion(const __detail::SparseSetBase* storage) {
+        return storage ? storage->layoutVersion() : 0;
+    }
+
+    template<typename T, typename... Ts>
+    inline size_t Query<T, Ts...>::size() const {
+        return cache->size();
+    }
+
+    template<typename T, typename... Ts>
+    inline const QueryStats& Query<T, Ts...>::stats() const {
+        return cache->stats();
+    }
+
+    template<typename T, typename... Ts>
+    inline Query<T, Ts...> ComponentManager::query() {
+        const Signature& required = signatureOf<
+            std::remove_const_t<T>,
+            std::remove_const_t<Ts>...
+        >();
+
+        for (auto& cache : queries) {
+            if (cache->signature() == required) {
+                ++cache->stats().hits;
+                return {*this, *cache};
+            }
+        }
+
+        auto cache = new __detail::QueryCache(required, signatureOf<Deleted>());
+        queries.emplace_back(cache);
+        ++cache->stats().misses;
+        cache->build(registry.signatures, registry.versions);
+        return {*this, *cache};
+    }
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef ENTITY_SYSTEM_QUERY_CACHE_HPP
+#define ENTITY_SYSTEM_QUERY_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Signature.hpp"
+#include "SparseSet.hpp"
+#include "types.hpp"
+
+namespace engine::entitysystem {
+    /**
+     * \brief Usage and maintenance counters of a cached query.
+     */
+    struct QueryStats {
+        // Number of query() calls served by the existing cache
+        size_t hits = 0;
+        // Number of query() calls that had to build the cache
+        size_t misses = 0;
+        // Number of entity signatures scanned while building the cache
+        size_t buildScans = 0;
+        // Number of forEach() calls
+        size_t iterations = 0;
+        // Number of entities passed to forEach() callbacks
+        size_t entitiesVisited = 0;
+        // Number of signature changes examined to keep the cache up to date
+        size_t maintenanceChecks = 0;
+        // Number of entities inserted into or removed from the cache
+        size_t maintenanceUpdates = 0;
+    };
+
+    namespace __detail {
+        /**
+         * \brief The list of entities whose signature contains a given set of
+         * components and none of a set of excluded ones, kept up to date as
+         * signatures change.
+         *
+         * Along with each entity, the cache saves the dense index of each of
+         * its required components, so that iterating doesn't look them up.
+         * The indexes are saved by resolve() and remain valid until one of
+         * the storages moves its components.
+         */
+        class QueryCache {
+         public:
+            using Storages = std::array<std::unique_ptr<SparseSetBase>, maxComponentTypes>;
+
+            QueryCache(const Signature& required, const Signature& excluded);
+
+            /**
+             * \brief Returns the components required by this query.
+             */
+            const Signature& signature() const;
+            /**
+             * \brief Fills the cache from scratch, given the signatures and
+             * versions of all entities, indexed by Entity::index.
+             */
+            void build(
+                const std::vector<Signature>& signatures,
+                const std::vector<Entity::Version>& versions
+            );
+            /**
+             * \brief Updates the cache after the signature of an entity changed.
+             */
+            void onSignatureChanged(Entity, const Signature& before, const Signature& after);
+            /**
+             * \brief Saves the dense indexes of the components of the cached
+             * entities, given the storages of all component types. Only the
+             * entities inserted since the last call are looked up, unless a
+             * storage moved its components since then.
+             */
+            void resolve(const Storages&);
+            /**
+             * \brief Returns the sum of the layout versions of the storages
+             * of the required components, which changes when any of them
+             * moves its components.
+             */
+            uint64_t layoutVersion(const Storages&) const;
+
+            size_t size() const;
+            Entity entityAt(size_t position) const;
+            /**
+             * \brief Returns the dense indexes saved by resolve() for the
+             * entity at a given position, one per required component.
+             */
+            const size_t* denseIndexesAt(size_t position) const;
+            /**
+             * \brief Returns the position of a required component in the
+             * rows returned by denseIndexesAt().
+             */
+            size_t columnOf(size_t componentId) const;
+            QueryStats& stats();
+            const QueryStats& stats() const;
+
+         private:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            Signature required;
+            Signature mask;
+            // Ids of the required components, in the order of `denseIndexes`
+            std::vector<size_t> componentIds;
+            // Column of each required component in `denseIndexes`, by id
+            std::array<uint8_t, maxComponentTypes> columns{};
+            std::vector<Entity> entities;
+            // Dense indexes of the components of each cached entity, one row
+            // of componentIds.size() indexes per entity
+            std::vector<size_t> denseIndexes;
+            // Number of rows of `denseIndexes` filled by resolve()
+            size_t numResolved = 0;
+            // Layout version of the storages when they were resolved
+            uint64_t resolvedLayout = 0;
+            // Position of each entity in `entities`, indexed by Entity::index
+            std::vector<size_t> positions;
+            QueryStats statistics;
+
+            bool matches(const Signature&) const;
+            void insert(Entity);
+            void erase(Entity);
+        };
+
+        inline QueryCache::QueryCache(const Signature& required, const Signature& excluded)
+         : required(required), mask(required | excluded) {
+            for (size_t id = 0; id < maxComponentTypes; ++id) {
+                if (required.test(id)) {
+                    columns[id] = componentIds.size();
+                    componentIds.push_back(id);
+                }
+            }
+        }
+
+        inline const Signature& QueryCache::signature() const {
+            return required;
+        }
+
+        inline void QueryCache::build(
+            const std::vector<Signature>& signatures,
+            const std::vector<Entity::Version>& versions
+        ) {
+            entities.clear();
+            denseIndexes.clear();
+            numResolved = 0;
+            positions.assign(signatures.size(), npos);
+
+            for (size_t index = 0; index < signatures.size(); ++index) {
+                if (matches(signatures[index])) {
+                    insert({static_cast<Entity::Index>(index), versions[index]});
+                }
+            }
+
+            statistics.buildScans += signatures.size();
+        }
+
+        inline void QueryCache::onSignatureChanged(
+            Entity entity,
+            const Signature& before,
+            const Signature& after
+        ) {
+            ++statistics.maintenanceChecks;
+            bool matchedBefore = matches(before);
+            bool matchesNow = matches(after);
+
+            if (matchedBefore == matchesNow) {
+                return;
+            }
+
+            ++statistics.maintenanceUpdates;
+
+            if (matchesNow) {
+                insert(entity);
+            } else {
+                erase(entity);
+            }
+        }
+
+        inline void QueryCache::resolve(const Storages& storages) {
+            uint64_t layout = layoutVersion(storages);
+
+            if (layout != resolvedLayout) {
+                resolvedLayout = layout;
+                numResolved = 0;
+            }
+
+            size_t numColumns = componentIds.size();
+
+            for (; numResolved < entities.size(); ++numResolved) {
+                size_t* row = denseIndexes.data() + numResolved * numColumns;
+
+                for (size_t column = 0; column < numColumns; ++column) {
+                    auto& storage = storages[componentIds[column]];
+                    row[column] = storage ? storage->indexOf(entities[numResolved]) : npos;
+                }
+            }
+        }
+
+        inline uint64_t QueryCache::layoutVersion(const Storages& storages) const {
+            uint64_t result = 0;
+
+            for (size_t id : componentIds) {
+                if (storages[id]) {
+                    result += storages[id]->layoutVersion();
+                }
+            }
+
+            return result;
+        }
+
+        inline size_t QueryCache::size() const {
+            return entities.size();
+        }
+
+        inline Entity QueryCache::entityAt(size_t position) const {
+            return entities[position];
+        }
+
+        inline const size_t* QueryCache::denseIndexesAt(size_t position) const {
+            return denseIndexes.data() + position * componentIds.size();
+        }
+
+        inline size_t QueryCache::columnOf(size_t componentId) const {
+            return columns[componentId];
+        }
+
+        inline QueryStats& QueryCache::stats() {
+            return statistics;
+        }
+
+        inline const QueryStats& QueryCache::stats() const {
+            return statistics;
+        }
+
+        inline bool QueryCache::matches(const Signature& signature) const {
+            return (signature & mask) == required;
+        }
+
+        inline void QueryCache::insert(Entity entity) {
+            if (entity.index >= positions.size()) {
+                positions.resize(entity.index + 1, npos);
+            }
+
+            positions[entity.index] = entities.size();
+            entities.push_back(entity);
+            denseIndexes.resize(denseIndexes.size() + componentIds.size(), npos);
+        }
+
+        inline void QueryCache::erase(Entity entity) {
+            size_t position = positions[entity.index];
+            size_t lastPosition = entities.size() - 1;
+            size_t numColumns = componentIds.size();
+            Entity lastEntity = entities.back();
+            entities[position] = lastEntity;
+            positions[lastEntity.index] = position;
+            std::copy_n(
+                denseIndexes.begin() + lastPosition * numColumns,
+                numColumns,
+                denseIndexes.begin() + position * numColumns
+            );
+            entities.pop_back();
+            denseIndexes.resize(denseIndexes.size() - numColumns);
+            positions[entity.index] = npos;
+
+            // The moved row may not have been resolved yet
+            if (lastPosition >= numResolved) {
+                numResolved = std::min(numResolved, position);
+            } else {
+                numResolved = std::min(numResolved, entities.size());
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef ENTITY_SYSTEM_SIGNATURE_HPP
+#define ENTITY_SYSTEM_SIGNATURE_HPP
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace engine::entitysystem {
+    /**
+     * \brief Maximum number of distinct component types.
+     */
+    constexpr size_t maxComponentTypes = 64;
+
+    /**
+     * \brief Set of component types bound to an entity, one bit per type.
+     */
+    using Signature = std::bitset<maxComponentTypes>;
+
+    /**
+     * \brief Tag components carry no data. They're stored only as a bit in
+     * the signature of the entities that have them.
+     */
+    template<typename TComponent>
+    constexpr bool isTagComponent = std::is_empty_v<TComponent>;
+
+    namespace __detail {
+        inline std::array<std::string, maxComponentTypes>& componentNames() {
+            static std::array<std::string, maxComponentTypes> names;
+            return names;
+        }
+
+        inline std::string demangle(const char* name) {
+            #ifdef __GNUG__
+                int status = 0;
+                std::unique_ptr<char, void(*)(void*)> result(
+                    abi::__cxa_demangle(name, nullptr, nullptr, &status),
+                    std::free
+                );
+
+                if (status == 0) {
+                    return result.get();
+                }
+            #endif
+
+            return name;
+        }
+
+        inline size_t nextComponentId(const std::type_info& type) {
+            static std::atomic<size_t> counter{0};
+            size_t id = counter++;
+
+            if (id >= maxComponentTypes) {
+                throw std::length_error("Too many component types");
+            }
+
+            componentNames()[id] = demangle(type.name());
+            return id;
+        }
+    }
+
+    /**
+     * \brief Returns the small integer that identifies a component type. IDs
+     * are assigned sequentially, the first time each type is used.
+     */
+    template<typename TComponent>
+    size_t componentId() {
+        static const size_t id = __detail::nextComponentId(typeid(TComponent));
+        return id;
+    }
+
+    /**
+     * \brief Returns the name of the component type with a given ID, or an
+     * empty string if no type has that ID yet.
+     */
+    inline const std::string& componentName(size_t id) {
+        return __detail::componentNames().at(id);
+    }
+
+    /**
+     * \brief Returns the signature that contains exactly the input components.
+     */
+    template<typename... TComponents>
+    const Signature& signatureOf() {
+        static const Signature signature = [] {
+            Signature result;
+            (result.set(componentId<TComponents>()), ...);
+            return result;
+        }();
+
+        return signature;
+    }
+}
+
+#endif
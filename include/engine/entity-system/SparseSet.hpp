@@ -0,0 +1,664 @@
+#ifndef ENTITY_SYSTEM_SPARSE_SET_HPP
+#define ENTITY_SYSTEM_SPARSE_SET_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Group.hpp"
+#include "types.hpp"
+
+namespace engine::entitysystem {
+    namespace __detail {
+        constexpr size_t floorPowerOfTwo(size_t value) {
+            size_t result = 1;
+
+            while (result * 2 <= value) {
+                result *= 2;
+            }
+
+            return result;
+        }
+
+        /**
+         * \brief Type-erased contents of a SparseSet captured by
+         * SparseSetBase::snapshot().
+         */
+        class SparseSetSnapshotBase {
+         public:
+            virtual ~SparseSetSnapshotBase() = default;
+        };
+
+        /**
+         * \brief Type-erased base of all SparseSets, which allows a
+         * ComponentManager to own and purge the storages of arbitrary
+         * component types.
+         */
+        class SparseSetBase {
+         public:
+            virtual ~SparseSetBase() = default;
+
+            /**
+             * \brief Removes the component of an entity, if any.
+             */
+            virtual void erase(Entity) = 0;
+            /**
+             * \brief Releases the pages that no longer hold any component.
+             */
+            virtual void shrinkToFit() = 0;
+            /**
+             * \brief Returns the number of stored components.
+             */
+            virtual size_t size() const = 0;
+            /**
+             * \brief Returns the number of components that can be stored
+             * without allocating a new page.
+             */
+            virtual size_t capacity() const = 0;
+            /**
+             * \brief Returns the number of bytes allocated by the set itself,
+             * not counting memory owned by the components.
+             */
+            virtual size_t memoryUsage() const = 0;
+            /**
+             * \brief Captures the contents of the set. The pages are shared
+             * with the snapshot until they are written. Throws
+             * std::logic_error if the components are not copyable.
+             */
+            virtual std::shared_ptr<const SparseSetSnapshotBase> snapshot() = 0;
+            /**
+             * \brief Brings back the contents captured by snapshot(), copying
+             * only the pages written since then, whose components are stamped
+             * with `tick`. A null snapshot empties the set.
+             */
+            virtual void restore(const SparseSetSnapshotBase*, Tick tick) = 0;
+            /**
+             * \brief Returns the dense index of an entity's component, or a
+             * value greater than or equal to size() if there is none.
+             */
+            virtual size_t indexOf(Entity) const = 0;
+
+            /**
+             * \brief Returns a counter that changes whenever components are
+             * moved to other dense indexes, so that saved indexes can be
+             * checked. Appending a component doesn't move any other.
+             */
+            uint64_t layoutVersion() const {
+                return layout;
+            }
+
+         protected:
+            uint64_t layout = 0;
+        };
+    }
+
+    /**
+     * \brief Stores the T components of a set of entities.
+     *
+     * The components are kept in a dense array, so iterating over all of them
+     * is a linear walk. A sparse array maps each entity index to a position
+     * in the dense array, making lookups, insertions and removals O(1). The
+     * dense array stores the full handles, so stale handles whose index was
+     * recycled are not mistaken for the current occupant.
+     *
+     * The dense array is split into fixed-size pages that are never moved,
+     * so references to a component remain valid when other components are
+     * added. Removing a component moves the last one into its position.
+     *
+     * Pages can be shared with snapshots, which keep a copy of a page only
+     * once it's about to be written. Writes are detected through the
+     * non-const methods, so references obtained before a snapshot must not
+     * be used to modify components afterwards.
+     *
+     * Each component has a change tick, which is maintained by the owner of
+     * the set and moves together with the component.
+     *
+     * A set may be owned by a group, which is notified about insertions and
+     * removals and may reorder the dense array through swapAt().
+     */
+    template<typename T>
+    class SparseSet final : public __detail::SparseSetBase {
+     public:
+        SparseSet() = default;
+        SparseSet(const SparseSet&) = delete;
+        SparseSet& operator=(const SparseSet&) = delete;
+        ~SparseSet() override;
+
+        /**
+         * \brief Checks if an entity has a component in this set.
+         */
+        bool contains(Entity) const;
+        size_t size() const override;
+        size_t capacity() const override;
+
+        /**
+         * \brief Constructs a component for an entity in-place. Does nothing
+         * if the entity already has a component in this set, mimicking
+         * `std::unordered_map::insert()`. Returns true if the component
+         * was inserted.
+         */
+        template<typename... Args>
+        bool emplace(Entity, Args&&...);
+        void erase(Entity) override;
+        /**
+         * \brief Removes all components.
+         */
+        void clear();
+        /**
+         * \brief Allocates enough pages to store at least `count` components.
+         */
+        void reserve(size_t count);
+        void shrinkToFit() override;
+        size_t memoryUsage() const override;
+        std::shared_ptr<const __detail::SparseSetSnapshotBase> snapshot() override;
+        void restore(const __detail::SparseSetSnapshotBase*, Tick tick) override;
+        /**
+         * \brief Copies the pages still shared with snapshots, so that the
+         * components can then be written concurrently.
+         */
+        void unshare();
+
+        /**
+         * \brief Returns the component of an entity. Throws std::out_of_range
+         * if the entity doesn't have one.
+         */
+        T& get(Entity);
+        const T& get(Entity) const;
+        size_t indexOf(Entity) const override;
+        /**
+         * \brief Returns the entity stored at a given dense index.
+         */
+        Entity entityAt(size_t index) const;
+        /**
+         * \brief Returns the component stored at a given dense index.
+         */
+        T& dataAt(size_t index);
+        const T& dataAt(size_t index) const;
+        /**
+         * \brief Returns the change tick of the component stored at a given
+         * dense index. Newly inserted components have tick 0.
+         */
+        Tick& changeTickAt(size_t index);
+        Tick changeTickAt(size_t index) const;
+        /**
+         * \brief Swaps the components (and entities) at two dense indexes.
+         */
+        void swapAt(size_t first, size_t second);
+
+        /**
+         * \brief Returns the group that owns this set, if any.
+         */
+        __detail::GroupBase* getGroup() const;
+        /**
+         * \brief Sets the group that owns this set.
+         */
+        void setGroup(__detail::GroupBase*);
+
+     private:
+        static constexpr size_t pageSize = __detail::floorPowerOfTwo(
+            std::max<size_t>(1, 16384 / sizeof(T))
+        );
+        static constexpr size_t sparsePageSize = 4096;
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        struct alignas(T) Slot {
+            unsigned char bytes[sizeof(T)];
+        };
+
+        // Contents of a page when a snapshot captured it. The copy is only
+        // made right before the page is written for the first time.
+        struct PageState {
+            PageState() = default;
+            PageState(const PageState&) = delete;
+            PageState& operator=(const PageState&) = delete;
+            ~PageState();
+
+            std::unique_ptr<Slot[]> copy;
+            size_t count = 0;
+        };
+
+        struct Page {
+            std::unique_ptr<Slot[]> slots;
+            // Shared with the snapshots that captured the page, if any
+            std::shared_ptr<PageState> state;
+        };
+
+        struct Snapshot : __detail::SparseSetSnapshotBase {
+            std::vector<std::shared_ptr<PageState>> pages;
+            std::vector<Entity> entities;
+            std::vector<Tick> changeTicks;
+            std::vector<std::shared_ptr<size_t[]>> sparse;
+        };
+
+        std::vector<Page> pages;
+        std::vector<Entity> entities;
+        std::vector<Tick> changeTicks;
+        // Copied on write as well, since snapshots share it
+        std::vector<std::shared_ptr<size_t[]>> sparse;
+        __detail::GroupBase* group = nullptr;
+
+        void destroyAll();
+        void addPage();
+        size_t countInPage(size_t page, size_t numComponents) const;
+        void detach(size_t page);
+        T* slot(size_t index);
+        const T* slot(size_t index) const;
+        T* writableSlot(size_t index);
+        size_t sparseIndex(Entity::Index) const;
+        size_t& sparseEntry(Entity::Index);
+    };
+
+    template<typename T>
+    inline SparseSet<T>::~SparseSet() {
+        destroyAll();
+    }
+
+    template<typename T>
+    inline SparseSet<T>::PageState::~PageState() {
+        for (size_t i = 0; i < count; ++i) {
+            std::launder(reinterpret_cast<T*>(&copy[i]))->~T();
+        }
+    }
+
+    template<typename T>
+    inline bool SparseSet<T>::contains(Entity entity) const {
+        return indexOf(entity) != npos;
+    }
+
+    template<typename T>
+    inline size_t SparseSet<T>::size() const {
+        return entities.size();
+    }
+
+    template<typename T>
+    inline size_t SparseSet<T>::capacity() const {
+        return pages.size() * pageSize;
+    }
+
+    template<typename T>
+    template<typename... Args>
+    inline bool SparseSet<T>::emplace(Entity entity, Args&&... args) {
+        if (contains(entity)) {
+            return false;
+        }
+
+        size_t index = entities.size();
+
+        if (index == capacity()) {
+            addPage();
+        }
+
+        new (writableSlot(index)) T(std::forward<Args>(args)...);
+        entities.push_back(entity);
+        changeTicks.push_back(0);
+        sparseEntry(entity.index) = index;
+
+        if (group) {
+            group->onInsert(entity);
+        }
+
+        return true;
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::erase(Entity entity) {
+        if (!contains(entity)) {
+            return;
+        }
+
+        if (group) {
+            group->onErase(entity);
+        }
+
+        size_t index = indexOf(entity);
+        size_t lastIndex = entities.size() - 1;
+        writableSlot(lastIndex);
+        writableSlot(index)->~T();
+
+        if (index != lastIndex) {
+            ++layout;
+            Entity lastEntity = entities[lastIndex];
+            new (slot(index)) T(std::move(*slot(lastIndex)));
+            slot(lastIndex)->~T();
+            entities[index] = lastEntity;
+            changeTicks[index] = changeTicks[lastIndex];
+            sparseEntry(lastEntity.index) = index;
+        }
+
+        entities.pop_back();
+        changeTicks.pop_back();
+        sparseEntry(entity.index) = npos;
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::clear() {
+        if (group) {
+            group->onClear();
+        }
+
+        ++layout;
+        destroyAll();
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::reserve(size_t count) {
+        while (capacity() < count) {
+            addPage();
+        }
+
+        entities.reserve(count);
+        changeTicks.reserve(count);
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::shrinkToFit() {
+        size_t usedPages = (entities.size() + pageSize - 1) / pageSize;
+        pages.resize(usedPages);
+        pages.shrink_to_fit();
+        entities.shrink_to_fit();
+        changeTicks.shrink_to_fit();
+
+        for (auto& page : sparse) {
+            if (page && std::all_of(page.get(), page.get() + sparsePageSize, [](size_t index) {
+                return index == npos;
+            })) {
+                page.reset();
+            }
+        }
+
+        while (!sparse.empty() && !sparse.back()) {
+            sparse.pop_back();
+        }
+
+        sparse.shrink_to_fit();
+    }
+
+    template<typename T>
+    inline size_t SparseSet<T>::memoryUsage() const {
+        size_t numSparsePages = std::count_if(sparse.begin(), sparse.end(), [](auto& page) {
+            return page != nullptr;
+        });
+
+        return pages.capacity() * sizeof(pages[0])
+            + pages.size() * pageSize * sizeof(Slot)
+            + entities.capacity() * sizeof(Entity)
+            + changeTicks.capacity() * sizeof(Tick)
+            + sparse.capacity() * sizeof(sparse[0])
+            + numSparsePages * sparsePageSize * sizeof(size_t);
+    }
+
+    template<typename T>
+    inline std::shared_ptr<const __detail::SparseSetSnapshotBase> SparseSet<T>::snapshot() {
+        if constexpr (!std::is_copy_constructible_v<T>) {
+            throw std::logic_error("SparseSet::snapshot: component type is not copyable");
+        } else {
+            auto result = std::make_shared<Snapshot>();
+            result->pages.reserve(pages.size());
+
+            for (auto& page : pages) {
+                if (!page.state) {
+                    page.state = std::make_shared<PageState>();
+                }
+
+                result->pages.push_back(page.state);
+            }
+
+            result->entities = entities;
+            result->changeTicks = changeTicks;
+            result->sparse = sparse;
+            return result;
+        }
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::restore(const __detail::SparseSetSnapshotBase* base, Tick tick) {
+        ++layout;
+
+        if (!base) {
+            destroyAll();
+            return;
+        }
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            auto& captured = static_cast<const Snapshot&>(*base);
+            std::vector<size_t> restoredPages;
+
+            while (pages.size() < captured.pages.size()) {
+                addPage();
+            }
+
+            for (size_t page = 0; page < pages.size(); ++page) {
+                bool wasCaptured = page < captured.pages.size();
+
+                if (wasCaptured && pages[page].state == captured.pages[page]) {
+                    continue;
+                }
+
+                size_t begin = page * pageSize;
+                size_t liveCount = countInPage(page, entities.size());
+                detach(page);
+
+                for (size_t i = 0; i < liveCount; ++i) {
+                    slot(begin + i)->~T();
+                }
+
+                if (wasCaptured) {
+                    const PageState& state = *captured.pages[page];
+
+                    for (size_t i = 0; i < state.count; ++i) {
+                        const Slot& raw = state.copy[i];
+                        new (slot(begin + i)) T(*std::launder(reinterpret_cast<const T*>(&raw)));
+                    }
+
+                    pages[page].state = captured.pages[page];
+                    restoredPages.push_back(page);
+                }
+            }
+
+            entities = captured.entities;
+            changeTicks = captured.changeTicks;
+            sparse = captured.sparse;
+
+            for (size_t page : restoredPages) {
+                size_t begin = page * pageSize;
+                std::fill_n(changeTicks.begin() + begin, countInPage(page, entities.size()), tick);
+            }
+        }
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::unshare() {
+        for (size_t page = 0; page < pages.size(); ++page) {
+            detach(page);
+        }
+    }
+
+    template<typename T>
+    inline T& SparseSet<T>::get(Entity entity) {
+        size_t index = indexOf(entity);
+
+        if (index == npos) {
+            throw std::out_of_range("SparseSet::get: entity has no such component");
+        }
+
+        return *writableSlot(index);
+    }
+
+    template<typename T>
+    inline const T& SparseSet<T>::get(Entity entity) const {
+        size_t index = indexOf(entity);
+
+        if (index == npos) {
+            throw std::out_of_range("SparseSet::get: entity has no such component");
+        }
+
+        return *slot(index);
+    }
+
+    template<typename T>
+    inline size_t SparseSet<T>::indexOf(Entity entity) const {
+        size_t index = sparseIndex(entity.index);
+
+        if (index == npos || entities[index] != entity) {
+            return npos;
+        }
+
+        return index;
+    }
+
+    template<typename T>
+    inline Entity SparseSet<T>::entityAt(size_t index) const {
+        return entities[index];
+    }
+
+    template<typename T>
+    inline T& SparseSet<T>::dataAt(size_t index) {
+        return *writableSlot(index);
+    }
+
+    template<typename T>
+    inline const T& SparseSet<T>::dataAt(size_t index) const {
+        return *slot(index);
+    }
+
+    template<typename T>
+    inline Tick& SparseSet<T>::changeTickAt(size_t index) {
+        return changeTicks[index];
+    }
+
+    template<typename T>
+    inline Tick SparseSet<T>::changeTickAt(size_t index) const {
+        return changeTicks[index];
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::swapAt(size_t first, size_t second) {
+        if (first == second) {
+            return;
+        }
+
+        ++layout;
+        writableSlot(second);
+        T temporary(std::move(*writableSlot(first)));
+        slot(first)->~T();
+        new (slot(first)) T(std::move(*slot(second)));
+        slot(second)->~T();
+        new (slot(second)) T(std::move(temporary));
+
+        std::swap(entities[first], entities[second]);
+        std::swap(changeTicks[first], changeTicks[second]);
+        sparseEntry(entities[first].index) = first;
+        sparseEntry(entities[second].index) = second;
+    }
+
+    template<typename T>
+    inline __detail::GroupBase* SparseSet<T>::getGroup() const {
+        return group;
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::setGroup(__detail::GroupBase* owner) {
+        group = owner;
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::destroyAll() {
+        for (size_t i = 0; i < entities.size(); ++i) {
+            writableSlot(i)->~T();
+            sparseEntry(entities[i].index) = npos;
+        }
+
+        entities.clear();
+        changeTicks.clear();
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::addPage() {
+        pages.push_back({std::unique_ptr<Slot[]>(new Slot[pageSize]), nullptr});
+    }
+
+    template<typename T>
+    inline size_t SparseSet<T>::countInPage(size_t page, size_t numComponents) const {
+        size_t begin = page * pageSize;
+        return begin < numComponents ? std::min(pageSize, numComponents - begin) : 0;
+    }
+
+    template<typename T>
+    inline void SparseSet<T>::detach(size_t page) {
+        auto& state = pages[page].state;
+
+        if (!state) {
+            return;
+        }
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            // Only snapshots that still exist need the current contents
+            if (!state->copy && state.use_count() > 1) {
+                size_t begin = page * pageSize;
+                size_t count = countInPage(page, entities.size());
+                state->copy.reset(new Slot[pageSize]);
+
+                for (; state->count < count; ++state->count) {
+                    new (&state->copy[state->count]) T(*slot(begin + state->count));
+                }
+            }
+        }
+
+        state.reset();
+    }
+
+    template<typename T>
+    inline T* SparseSet<T>::slot(size_t index) {
+        Slot& raw = pages[index / pageSize].slots[index % pageSize];
+        return std::launder(reinterpret_cast<T*>(&raw));
+    }
+
+    template<typename T>
+    inline const T* SparseSet<T>::slot(size_t index) const {
+        const Slot& raw = pages[index / pageSize].slots[index % pageSize];
+        return std::launder(reinterpret_cast<const T*>(&raw));
+    }
+
+    template<typename T>
+    inline T* SparseSet<T>::writableSlot(size_t index) {
+        detach(index / pageSize);
+        return slot(index);
+    }
+
+    template<typename T>
+    inline size_t SparseSet<T>::sparseIndex(Entity::Index entity) const {
+        size_t page = entity / sparsePageSize;
+
+        if (page >= sparse.size() || !sparse[page]) {
+            return npos;
+        }
+
+        return sparse[page][entity % sparsePageSize];
+    }
+
+    template<typename T>
+    inline size_t& SparseSet<T>::sparseEntry(Entity::Index entity) {
+        size_t page = entity / sparsePageSize;
+
+        if (page >= sparse.size()) {
+            sparse.resize(page + 1);
+        }
+
+        if (!sparse[page]) {
+            sparse[page].reset(new size_t[sparsePageSize]);
+            std::fill_n(sparse[page].get(), sparsePageSize, npos);
+        } else if (sparse[page].use_count() > 1) {
+            std::shared_ptr<size_t[]> copy(new size_t[sparsePageSize]);
+            std::copy_n(sparse[page].get(), sparsePageSize, copy.get());
+            sparse[page] = std::move(copy);
+        }
+
+        return sparse[page][entity % sparsePageSize];
+    }
+}
+
+#endif
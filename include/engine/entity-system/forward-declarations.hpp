@@ -1,3 +1,4 @@
 namespace engine::entitysystem {
+    class CommandBuffer;
     class ComponentManager;
 }
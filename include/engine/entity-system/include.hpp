@@ -1,2 +1,4 @@
+#include "CommandBuffer.hpp"
 #include "ComponentManager.hpp"
+#include "Query.hpp"
 #include "types.hpp"
@@ -2,9 +2,55 @@
 #define ENTITY_SYSTEM_TYPES_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
 
 namespace engine::entitysystem {
-    using Entity = size_t;
+    /**
+     * \brief Handle to an entity.
+     *
+     * The index identifies a slot in the per-entity arrays, which is reused
+     * once the entity is destroyed. The version tells the successive
+     * occupants of a slot apart, so that stale handles can be detected.
+     * Live entities never have version 0, so a default-constructed handle
+     * never refers to one.
+     */
+    struct Entity {
+        using Index = uint32_t;
+        using Version = uint32_t;
+
+        Index index = 0;
+        Version version = 0;
+    };
+
+    inline bool operator==(Entity lhs, Entity rhs) {
+        return lhs.index == rhs.index && lhs.version == rhs.version;
+    }
+
+    inline bool operator!=(Entity lhs, Entity rhs) {
+        return !(lhs == rhs);
+    }
+
+    inline std::ostream& operator<<(std::ostream& stream, Entity entity) {
+        return stream << entity.index << 'v' << entity.version;
+    }
+}
+
+namespace engine::entitysystem {
+    /**
+     * \brief Logical timestamp used to detect component changes.
+     */
+    using Tick = uint64_t;
+}
+
+namespace std {
+    template<>
+    struct hash<engine::entitysystem::Entity> {
+        size_t operator()(engine::entitysystem::Entity entity) const {
+            return (static_cast<uint64_t>(entity.version) << 32) | entity.index;
+        }
+    };
 }
 
 #endif
@@ -0,0 +1,111 @@
+#ifndef RESOURCE_SYSTEM_FILE_WATCHER_HPP
+#define RESOURCE_SYSTEM_FILE_WATCHER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::resourcesystem {
+    /**
+     * \brief Watches directories for files that are written, using
+     * inotify. Subdirectories aren't watched.
+     */
+    class FileWatcher {
+     public:
+        /**
+         * \brief Throws std::runtime_error if inotify isn't available.
+         */
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        /**
+         * \brief Starts watching a directory. Throws std::runtime_error if
+         * it can't be watched.
+         */
+        void watch(const std::string& directory);
+
+        /**
+         * \brief Returns the path of every file that was written or moved
+         * into a watched directory since the last call, each once, without
+         * blocking.
+         */
+        std::vector<std::string> poll();
+
+     private:
+        int fd;
+        // Watched directories by watch descriptor, ending with a slash
+        std::unordered_map<int, std::string> directories;
+    };
+
+    inline FileWatcher::FileWatcher() : fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+        if (fd < 0) {
+            throw std::runtime_error("Failed to initialize inotify");
+        }
+    }
+
+    inline FileWatcher::~FileWatcher() {
+        ::close(fd);
+    }
+
+    inline void FileWatcher::watch(const std::string& directory) {
+        // Editors either rewrite a file or move a new one over it
+        int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+
+        if (wd < 0) {
+            throw std::runtime_error("Failed to watch directory: " + directory);
+        }
+
+        std::string& path = directories[wd];
+        path = directory;
+
+        if (path.empty() || path.back() != '/') {
+            path += '/';
+        }
+    }
+
+    inline std::vector<std::string> FileWatcher::poll() {
+        std::vector<std::string> changedFiles;
+        alignas(inotify_event) char buffer[4096];
+
+        while (true) {
+            ssize_t length = ::read(fd, buffer, sizeof(buffer));
+
+            if (length <= 0) {
+                if (length < 0 && errno == EINTR) {
+                    continue;
+                }
+
+                // EAGAIN: there are no more events
+                break;
+            }
+
+            for (ssize_t offset = 0; offset < length; ) {
+                auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+                auto directory = directories.find(event->wd);
+
+                if (event->len == 0 || directory == directories.end()) {
+                    continue;
+                }
+
+                std::string path = directory->second + event->name;
+
+                if (std::find(changedFiles.begin(), changedFiles.end(), path) == changedFiles.end()) {
+                    changedFiles.push_back(std::move(path));
+                }
+            }
+        }
+
+        return changedFiles;
+    }
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef RESOURCE_SYSTEM_RESOURCE_LOADER_HPP
+#define RESOURCE_SYSTEM_RESOURCE_LOADER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::resourcesystem {
+    /**
+     * \brief Progress of a ResourceLoader, reported after each task commits.
+     */
+    struct LoadingProgress {
+        size_t completed = 0;
+        size_t total = 0;
+        // Name of the last committed task
+        std::string current;
+
+        bool finished() const {
+            return completed == total;
+        }
+    };
+
+    /**
+     * \brief Runs a graph of loading tasks in the background.
+     *
+     * Each task has two steps. `load` runs on a worker thread and must not
+     * touch shared state such as the ResourceStorage: it is meant for file
+     * reads, parsing and decoding. `commit` runs on the thread that calls
+     * update(), which should be the one that owns the graphics context, and
+     * is where GPU uploads and storage writes happen. A task is only loaded
+     * once all of its dependencies have committed, so it can read whatever
+     * they produced.
+     */
+    class ResourceLoader {
+     public:
+        using Step = std::function<void()>;
+        using ProgressCallback = std::function<void(const LoadingProgress&)>;
+
+        /**
+         * \brief Creates a loader that runs `load` steps on `numThreads`
+         * worker threads. Defaults to one less than the number of hardware
+         * threads, leaving one for the caller.
+         */
+        explicit ResourceLoader(size_t numThreads = defaultNumThreads());
+        ~ResourceLoader();
+
+        ResourceLoader(const ResourceLoader&) = delete;
+        ResourceLoader(ResourceLoader&&) = delete;
+        ResourceLoader& operator=(const ResourceLoader&) = delete;
+        ResourceLoader& operator=(ResourceLoader&&) = delete;
+
+        /**
+         * \brief Adds a task. Dependencies are referred to by name and
+         * don't need to be added beforehand. Throws std::logic_error if the
+         * loader has already started or the name is taken.
+         */
+        void add(
+            const std::string& name,
+            const std::vector<std::string>& dependencies,
+            Step load,
+            Step commit
+        );
+
+        /**
+         * \brief Sets a function to be called on the committing thread
+         * after each task commits.
+         */
+        void setProgressCallback(ProgressCallback callback);
+
+        /**
+         * \brief Starts loading the tasks that have no dependencies. Throws
+         * std::logic_error if a dependency is unknown or there's a cycle.
+         */
+        void start();
+
+        /**
+         * \brief Commits every task whose load step has finished and
+         * schedules the tasks that depend on them. Rethrows the first
+         * exception thrown by a step. Returns true once all tasks have
+         * committed.
+         */
+        bool update();
+
+        /**
+         * \brief Calls update() until all tasks have committed, blocking
+         * in between.
+         */
+        void wait();
+
+        const LoadingProgress& progress() const;
+
+        /**
+         * \brief Returns the number of worker threads.
+         */
+        size_t size() const;
+
+        static size_t defaultNumThreads();
+
+     private:
+        struct Task {
+            std::string name;
+            std::vector<std::string> dependencies;
+            Step load;
+            Step commit;
+            std::vector<size_t> dependents;
+            size_t remainingDependencies = 0;
+        };
+
+        std::vector<Task> tasks;
+        std::unordered_map<std::string, size_t> taskIndexes;
+        std::vector<std::thread> workers;
+        size_t numThreads;
+        ProgressCallback progressCallback;
+        LoadingProgress currentProgress;
+        bool started = false;
+
+        std::mutex mutex;
+        std::condition_variable loadAvailable;
+        std::condition_variable loadFinished;
+        std::deque<size_t> pendingLoads;
+        std::deque<size_t> pendingCommits;
+        std::exception_ptr error;
+        bool stopping = false;
+
+        void workerLoop();
+        void schedule(size_t taskIndex);
+    };
+}
+
+#endif
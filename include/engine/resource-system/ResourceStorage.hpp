@@ -1,68 +1,272 @@
 #ifndef RESOURCE_STORAGE_HPP
 #define RESOURCE_STORAGE_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace engine::resourcesystem {
     namespace __detail {
-        template<typename Key, typename T>
-        T& typeMap() {
-            static T value;
-            return value;
+        inline size_t nextResourceTypeId() {
+            static std::atomic<size_t> counter{0};
+            return counter++;
         }
 
+        /**
+         * \brief Returns the small integer that identifies a resource type,
+         * assigned the first time each type is used.
+         */
         template<typename TResource>
-        using ResourceDataStorage = std::unordered_map<std::string, TResource>;
+        size_t resourceTypeId() {
+            static const size_t id = nextResourceTypeId();
+            return id;
+        }
 
-        template<typename TResource>
-        ResourceDataStorage<TResource>& resourceData() {
-            return typeMap<TResource, ResourceDataStorage<TResource>>();
+        /**
+         * \brief Type-erased base of the per-type resource containers.
+         */
+        class ResourceDataStorageBase {
+         public:
+            virtual ~ResourceDataStorageBase() = default;
+        };
+
+        constexpr uint64_t fnv1a(std::string_view text) {
+            uint64_t hash = 14695981039346656037ull;
+
+            for (char ch : text) {
+                hash = (hash ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+            }
+
+            return hash;
         }
     }
 
+    /**
+     * \brief Identifier of a resource, hashed on construction. Identifiers
+     * built from literals in a constant expression are hashed at compile time.
+     */
+    struct ResourceId {
+        constexpr ResourceId(const char* name) : ResourceId(std::string_view(name)) { }
+        constexpr ResourceId(std::string_view name) : name(name), hash(__detail::fnv1a(name)) { }
+        ResourceId(const std::string& name) : ResourceId(std::string_view(name)) { }
+
+        std::string_view name;
+        uint64_t hash;
+    };
+
+    /**
+     * \brief Stable reference to a T resource of a given ResourceStorage,
+     * returned by ResourceStorage::handle(). Looking a resource up through
+     * its handle is an array access, with no hashing.
+     */
+    template<typename T>
+    struct ResourceHandle {
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        size_t index = npos;
+    };
+
+    namespace __detail {
+        /**
+         * \brief Holds the T resources. Each identifier is interned into a
+         * slot the first time it's used, and keeps that slot even if its
+         * resource is removed, so handles never go stale.
+         */
+        template<typename TResource>
+        class ResourceDataStorage : public ResourceDataStorageBase {
+         public:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            // Resources by slot, null for identifiers without one
+            std::vector<std::unique_ptr<TResource>> values;
+            std::vector<std::string> names;
+            // Slots by identifier hash
+            std::unordered_multimap<uint64_t, size_t> slots;
+
+            size_t find(const ResourceId& id) const {
+                auto [begin, end] = slots.equal_range(id.hash);
+
+                for (auto it = begin; it != end; ++it) {
+                    if (names[it->second] == id.name) {
+                        return it->second;
+                    }
+                }
+
+                return npos;
+            }
+
+            size_t intern(const ResourceId& id) {
+                size_t slot = find(id);
+
+                if (slot == npos) {
+                    slot = values.size();
+                    values.emplace_back();
+                    names.emplace_back(id.name);
+                    slots.insert({id.hash, slot});
+                }
+
+                return slot;
+            }
+        };
+    }
+
     /**
      * \brief Stores arbitrary resource data, which can be retrieved by
-     * their identifiers.
+     * their identifiers or, without hashing, by handles. The data is owned
+     * by the instance.
      */
     class ResourceStorage {
     public:
+        ResourceStorage() = default;
+        ResourceStorage(const ResourceStorage&) = delete;
+        ResourceStorage& operator=(const ResourceStorage&) = delete;
+
+        /**
+         * \brief Stores data, assigning it a given identifier. Does nothing
+         * if the identifier already has data.
+         */
+        template<typename T>
+        void store(const ResourceId& identifier, T&& data);
+
         /**
-         * \brief Stores data, assigning it a given identifier.
+         * \brief Replaces the data of an identifier by assigning to it, so
+         * references to the old data remain valid and see the new one.
+         * Stores the data if the identifier has none.
          */
         template<typename T>
-        void store(const std::string& identifier, T&& data);
+        void replace(const ResourceId& identifier, T&& data);
 
         /**
          * \brief Retrieves previously stored data. Throws if the identifier
          * is invalid.
          */
         template<typename T>
-        T& get(const std::string& identifier) const;
+        T& get(const ResourceId& identifier) const;
+        /**
+         * \brief Retrieves previously stored data through a handle. Throws
+         * if there is no data for it.
+         */
+        template<typename T>
+        T& get(ResourceHandle<T>) const;
+
+        /**
+         * \brief Returns the handle of a T identifier, which remains valid
+         * for the lifetime of the storage, even across remove() and store().
+         * The identifier doesn't need to have data yet.
+         */
+        template<typename T>
+        ResourceHandle<T> handle(const ResourceId& identifier);
 
         /**
          * \brief Removes data assigned to the given identifier.
          */
         template<typename T>
-        void remove(const std::string& identifier);
+        void remove(const ResourceId& identifier);
+
+    private:
+        // Indexed by resource type ID
+        std::vector<std::unique_ptr<__detail::ResourceDataStorageBase>> storages;
+
+        template<typename T>
+        __detail::ResourceDataStorage<T>& resourceData();
+        template<typename T>
+        __detail::ResourceDataStorage<T>* findResourceData() const;
     };
 
     template<typename T>
-    void ResourceStorage::store(const std::string& identifier, T&& data) {
-        __detail::resourceData<std::decay_t<T>>().insert({
-            identifier,
-            std::forward<T>(data)
-        });
+    void ResourceStorage::store(const ResourceId& identifier, T&& data) {
+        auto& storage = resourceData<std::decay_t<T>>();
+        auto& value = storage.values[storage.intern(identifier)];
+
+        if (!value) {
+            value.reset(new std::decay_t<T>(std::forward<T>(data)));
+        }
+    }
+
+    template<typename T>
+    void ResourceStorage::replace(const ResourceId& identifier, T&& data) {
+        auto& storage = resourceData<std::decay_t<T>>();
+        auto& value = storage.values[storage.intern(identifier)];
+
+        if (value) {
+            *value = std::forward<T>(data);
+        } else {
+            value.reset(new std::decay_t<T>(std::forward<T>(data)));
+        }
+    }
+
+    template<typename T>
+    T& ResourceStorage::get(const ResourceId& identifier) const {
+        constexpr size_t npos = __detail::ResourceDataStorage<T>::npos;
+        auto storage = findResourceData<T>();
+        size_t slot = storage ? storage->find(identifier) : npos;
+
+        if (slot == npos || !storage->values[slot]) {
+            throw std::out_of_range(
+                "ResourceStorage::get: unknown identifier " + std::string(identifier.name)
+            );
+        }
+
+        return *storage->values[slot];
+    }
+
+    template<typename T>
+    T& ResourceStorage::get(ResourceHandle<T> handle) const {
+        auto storage = findResourceData<T>();
+
+        if (!storage || handle.index >= storage->values.size() || !storage->values[handle.index]) {
+            throw std::out_of_range("ResourceStorage::get: no data for handle");
+        }
+
+        return *storage->values[handle.index];
     }
 
     template<typename T>
-    T& ResourceStorage::get(const std::string& identifier) const {
-        return __detail::resourceData<T>().at(identifier);
+    ResourceHandle<T> ResourceStorage::handle(const ResourceId& identifier) {
+        return {resourceData<T>().intern(identifier)};
     }
 
     template<typename T>
-    void ResourceStorage::remove(const std::string& identifier) {
-        __detail::resourceData<T>().erase(identifier);
+    void ResourceStorage::remove(const ResourceId& identifier) {
+        if (auto storage = findResourceData<T>()) {
+            size_t slot = storage->find(identifier);
+
+            if (slot != storage->npos) {
+                storage->values[slot].reset();
+            }
+        }
+    }
+
+    template<typename T>
+    __detail::ResourceDataStorage<T>& ResourceStorage::resourceData() {
+        size_t id = __detail::resourceTypeId<T>();
+
+        if (id >= storages.size()) {
+            storages.resize(id + 1);
+        }
+
+        if (!storages[id]) {
+            storages[id].reset(new __detail::ResourceDataStorage<T>());
+        }
+
+        return static_cast<__detail::ResourceDataStorage<T>&>(*storages[id]);
+    }
+
+    template<typename T>
+    __detail::ResourceDataStorage<T>* ResourceStorage::findResourceData() const {
+        size_t id = __detail::resourceTypeId<T>();
+
+        if (id >= storages.size() || !storages[id]) {
+            return nullptr;
+        }
+
+        return static_cast<__detail::ResourceDataStorage<T>*>(storages[id].get());
     }
 }
 
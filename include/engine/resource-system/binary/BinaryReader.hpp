@@ -0,0 +1,116 @@
+#ifndef BINARY_READER_HPP
+#define BINARY_READER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace engine::resourcesystem {
+    /**
+     * \brief Reads values written by BinaryWriter from a byte range, in
+     * place. Throws std::out_of_range when reading past the end.
+     */
+    class BinaryReader {
+     public:
+        BinaryReader() = default;
+        BinaryReader(const char* data, size_t size) : data(data), length(size) { }
+
+        uint8_t readU8() {
+            return static_cast<uint8_t>(*take(1));
+        }
+
+        uint32_t readU32() {
+            return static_cast<uint32_t>(readLittleEndian(4));
+        }
+
+        uint64_t readU64() {
+            return readLittleEndian(8);
+        }
+
+        int32_t readInt() {
+            return static_cast<int32_t>(readU32());
+        }
+
+        int64_t readInt64() {
+            return static_cast<int64_t>(readU64());
+        }
+
+        float readFloat() {
+            uint32_t bits = readU32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        double readDouble() {
+            uint64_t bits = readU64();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        bool readBool() {
+            return readU8() != 0;
+        }
+
+        /**
+         * \brief Returns a view of a string written by writeString(),
+         * pointing into the underlying bytes.
+         */
+        std::string_view readString() {
+            uint32_t size = readU32();
+            return {take(size), size};
+        }
+
+        /**
+         * \brief Returns a view of the next `size` raw bytes.
+         */
+        std::string_view readBytes(size_t size) {
+            return {take(size), size};
+        }
+
+        /**
+         * \brief Returns a reader over the next `size` bytes and skips them.
+         */
+        BinaryReader sub(size_t size) {
+            return {take(size), size};
+        }
+
+        size_t position() const {
+            return offset;
+        }
+
+        size_t remaining() const {
+            return length - offset;
+        }
+
+     private:
+        const char* data = nullptr;
+        size_t length = 0;
+        size_t offset = 0;
+
+        const char* take(size_t size) {
+            if (size > remaining()) {
+                throw std::out_of_range("BinaryReader: unexpected end of data");
+            }
+
+            const char* result = data + offset;
+            offset += size;
+            return result;
+        }
+
+        uint64_t readLittleEndian(size_t numBytes) {
+            const char* bytes = take(numBytes);
+            uint64_t value = 0;
+
+            for (size_t i = 0; i < numBytes; ++i) {
+                value |= uint64_t(static_cast<uint8_t>(bytes[i])) << (8 * i);
+            }
+
+            return value;
+        }
+    };
+}
+
+#endif
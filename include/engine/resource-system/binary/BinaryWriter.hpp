@@ -0,0 +1,100 @@
+#ifndef BINARY_WRITER_HPP
+#define BINARY_WRITER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace engine::resourcesystem {
+    /**
+     * \brief Appends values to a byte buffer in a fixed little-endian
+     * layout, readable by BinaryReader.
+     */
+    class BinaryWriter {
+     public:
+        void writeU8(uint8_t value) {
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        void writeU32(uint32_t value) {
+            for (size_t i = 0; i < 4; ++i) {
+                writeU8(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void writeU64(uint64_t value) {
+            for (size_t i = 0; i < 8; ++i) {
+                writeU8(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void writeInt(int32_t value) {
+            writeU32(static_cast<uint32_t>(value));
+        }
+
+        void writeInt64(int64_t value) {
+            writeU64(static_cast<uint64_t>(value));
+        }
+
+        void writeFloat(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeU32(bits);
+        }
+
+        void writeDouble(double value) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeU64(bits);
+        }
+
+        void writeBool(bool value) {
+            writeU8(value ? 1 : 0);
+        }
+
+        /**
+         * \brief Writes raw bytes, without their length.
+         */
+        void writeBytes(std::string_view bytes) {
+            buffer.append(bytes.data(), bytes.size());
+        }
+
+        /**
+         * \brief Writes a string as its length followed by its characters.
+         */
+        void writeString(std::string_view value) {
+            writeU32(static_cast<uint32_t>(value.size()));
+            buffer.append(value.data(), value.size());
+        }
+
+        /**
+         * \brief Overwrites a previously written u32, e.g a size that was
+         * only known after writing what follows it.
+         */
+        void patchU32(size_t offset, uint32_t value) {
+            for (size_t i = 0; i < 4; ++i) {
+                buffer[offset + i] = static_cast<char>(value >> (8 * i));
+            }
+        }
+
+        void patchU64(size_t offset, uint64_t value) {
+            for (size_t i = 0; i < 8; ++i) {
+                buffer[offset + i] = static_cast<char>(value >> (8 * i));
+            }
+        }
+
+        size_t size() const {
+            return buffer.size();
+        }
+
+        const std::string& data() const {
+            return buffer;
+        }
+
+     private:
+        std::string buffer;
+    };
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace engine::resourcesystem {
+    /**
+     * \brief Maps a whole file into memory, read-only. Throws
+     * std::runtime_error if the file can't be opened or mapped.
+     */
+    class MappedFile {
+     public:
+        explicit MappedFile(const std::string& filename);
+        MappedFile(MappedFile&&);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        const char* data() const {
+            return bytes;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+     private:
+        const char* bytes = nullptr;
+        size_t length = 0;
+    };
+
+    inline MappedFile::MappedFile(const std::string& filename) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+
+        struct stat status;
+
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat file: " + filename);
+        }
+
+        length = static_cast<size_t>(status.st_size);
+
+        // mmap() rejects empty mappings, and there's nothing to read anyway
+        if (length > 0) {
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map file: " + filename);
+            }
+
+            bytes = static_cast<const char*>(address);
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    inline MappedFile::MappedFile(MappedFile&& other)
+     : bytes(other.bytes), length(other.length) {
+        other.bytes = nullptr;
+        other.length = 0;
+    }
+
+    inline MappedFile::~MappedFile() {
+        if (bytes) {
+            ::munmap(const_cast<char*>(bytes), length);
+        }
+    }
+}
+
+#endif
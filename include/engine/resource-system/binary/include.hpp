@@ -0,0 +1,3 @@
+#include "BinaryReader.hpp"
+#include "BinaryWriter.hpp"
+#include "MappedFile.hpp"
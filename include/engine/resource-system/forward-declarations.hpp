@@ -1,3 +1,5 @@
 namespace engine::resourcesystem {
+    struct LoadingProgress;
+    class ResourceLoader;
     class ResourceStorage;
 }
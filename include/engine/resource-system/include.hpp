@@ -1 +1,2 @@
+#include "ResourceLoader.hpp"
 #include "ResourceStorage.hpp"
@@ -0,0 +1,87 @@
+#ifndef JSON_ARENA_HPP
+#define JSON_ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * \brief Bump allocator holding every node and string of a JSON document.
+ * Nothing is freed until the whole arena is. Shared by the values that
+ * own the document through an intrusive reference count.
+ */
+class JsonArena {
+ public:
+    JsonArena() = default;
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+        return count > 0 ? static_cast<T*>(allocate(sizeof(T) * count, alignof(T))) : nullptr;
+    }
+
+    /**
+     * \brief Copies a string into the arena, followed by a null character.
+     */
+    std::string_view copyString(std::string_view text);
+
+    void addReference() {
+        references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Returns true if the reference removed was the last one.
+     */
+    bool removeReference() {
+        return references.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+ private:
+    static constexpr size_t minBlockSize = 256;
+    static constexpr size_t maxBlockSize = 1 << 20;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* current = nullptr;
+    size_t remaining = 0;
+    size_t nextBlockSize = minBlockSize;
+    std::atomic<size_t> references{1};
+};
+
+inline void* JsonArena::allocate(size_t size, size_t alignment) {
+    size_t padding = -reinterpret_cast<uintptr_t>(current) & (alignment - 1);
+
+    if (padding + size > remaining) {
+        // Blocks come from new[], which aligns them for any type
+        size_t blockSize = std::max(nextBlockSize, size);
+        blocks.emplace_back(new char[blockSize]);
+        current = blocks.back().get();
+        remaining = blockSize;
+        padding = 0;
+        nextBlockSize = std::min(nextBlockSize * 2, maxBlockSize);
+    }
+
+    char* result = current + padding;
+    current = result + size;
+    remaining -= padding + size;
+    return result;
+}
+
+inline std::string_view JsonArena::copyString(std::string_view text) {
+    char* copy = static_cast<char*>(allocate(text.size() + 1, 1));
+
+    if (!text.empty()) {
+        std::memcpy(copy, text.data(), text.size());
+    }
+
+    copy[text.size()] = '\0';
+    return {copy, text.size()};
+}
+
+#endif
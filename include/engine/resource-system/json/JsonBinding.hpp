@@ -0,0 +1,644 @@
+#ifndef JSON_BINDING_HPP
+#define JSON_BINDING_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "JsonReader.hpp"
+#include "JsonValue.hpp"
+#include "parse-json.hpp"
+
+/**
+ * \brief Describes how a struct is read from JSON. Specializations define
+ * either `fields`, a tuple of jsonField() read from an object, or
+ * `elements`, a tuple of member pointers read in order from an array:
+ *
+ *     template<>
+ *     struct JsonBinding<Move> {
+ *         static constexpr auto fields = std::make_tuple(
+ *             jsonField("power", &Move::power),
+ *             ...
+ *         );
+ *     };
+ *
+ * The key of each field must be present unless it's made with
+ * jsonOptional() instead, and an object can't have keys without a field. A
+ * struct can have up to 64 fields.
+ *
+ * Members can be integers, floating point numbers (also read from
+ * integers), bools, strings, JsonValues (kept as documents), vectors, std::arrays, pairs and
+ * tuples (read from arrays unless a field gives them a binding),
+ * string-keyed unordered_maps and vectors of string-keyed pairs (read from
+ * objects), and bound structs. Numbers that don't fit their member throw.
+ */
+template<typename T>
+struct JsonBinding;
+
+/**
+ * \brief A member read from the value of a key. `FieldBinding` is used
+ * instead of JsonBinding for the structs inside the member.
+ */
+template<typename Owner, typename Member, typename FieldBinding>
+struct JsonField {
+    using Binding = FieldBinding;
+
+    std::string_view key;
+    Member Owner::* member;
+    // Whether the key can be missing, in which case the member is left as
+    // it was
+    bool optional;
+};
+
+template<typename Binding = void, typename Owner, typename Member>
+constexpr JsonField<Owner, Member, Binding> jsonField(std::string_view key, Member Owner::* member) {
+    return {key, member, false};
+}
+
+template<typename Binding = void, typename Owner, typename Member>
+constexpr JsonField<Owner, Member, Binding> jsonOptional(std::string_view key, Member Owner::* member) {
+    return {key, member, true};
+}
+
+namespace __detail {
+    struct JsonOps;
+    struct JsonFields;
+
+    // Where a value is read to; values without operations are skipped
+    struct JsonTarget {
+        void* object = nullptr;
+        const JsonOps* ops = nullptr;
+    };
+
+    /**
+     * \brief How values are read into a type, with the type erased. The
+     * operations the type doesn't support are null.
+     */
+    struct JsonOps {
+        void (*setString)(void*, std::string_view) = nullptr;
+        void (*setNumber)(void*, int64_t) = nullptr;
+        void (*setDouble)(void*, double) = nullptr;
+        void (*setBool)(void*, bool) = nullptr;
+        void (*setDocument)(void*, JsonValue&&) = nullptr;
+        // Returns where the element at an index goes, for arrays
+        JsonTarget (*element)(void*, size_t) = nullptr;
+        // Returns where the member with a key goes, for maps
+        JsonTarget (*member)(void*, std::string_view) = nullptr;
+        // The fields read from an object, for bound structs
+        const JsonFields* fields = nullptr;
+    };
+
+    /**
+     * \brief The fields of a struct bound to an object.
+     */
+    struct JsonFields {
+        const std::string_view* keys;
+        size_t count;
+        // Bit i is set if the key of field i can't be missing
+        uint64_t required;
+        // Returns the index of the field with a key, or `count`
+        size_t (*find)(std::string_view);
+        // Returns where the field at an index goes
+        JsonTarget (*target)(void*, size_t);
+    };
+
+    constexpr uint64_t hashKey(std::string_view key) {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (char ch : key) {
+            hash = (hash ^ static_cast<unsigned char>(ch)) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    /**
+     * \brief Size of the smallest table in which no two of the hashes fall
+     * in the same slot, or 0 if there's none, as with duplicate keys.
+     */
+    template<size_t N>
+    constexpr size_t perfectTableSize(const std::array<uint64_t, N>& hashes) {
+        for (size_t size = N > 0 ? N : 1; size <= 16 * N + 16; ++size) {
+            bool distinct = true;
+
+            for (size_t i = 0; i < N && distinct; ++i) {
+                for (size_t j = i + 1; j < N && distinct; ++j) {
+                    distinct = hashes[i] % size != hashes[j] % size;
+                }
+            }
+
+            if (distinct) {
+                return size;
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * \brief The keys of a bound struct and their perfect hash table, so a
+     * key is found with one hash, one lookup and one comparison.
+     */
+    template<typename Binding>
+    struct JsonKeys {
+        static constexpr size_t count = std::tuple_size_v<std::decay_t<decltype(Binding::fields)>>;
+        static_assert(count <= 64, "JSON binding has more than 64 fields");
+
+        static constexpr std::array<std::string_view, count> keys = std::apply([](const auto&... fields) {
+            return std::array<std::string_view, count>{fields.key...};
+        }, Binding::fields);
+
+        static constexpr std::array<uint64_t, count> hashes = [] {
+            std::array<uint64_t, count> result{};
+
+            for (size_t i = 0; i < count; ++i) {
+                result[i] = hashKey(keys[i]);
+            }
+
+            return result;
+        }();
+
+        static constexpr uint64_t required = std::apply([](const auto&... fields) {
+            uint64_t result = 0;
+            size_t index = 0;
+            ((result |= uint64_t(!fields.optional) << index++), ...);
+            return result;
+        }, Binding::fields);
+
+        static constexpr size_t tableSize = perfectTableSize(hashes);
+        static_assert(tableSize > 0, "JSON binding has duplicate keys");
+
+        // Index of the field of each slot, or `count` for empty slots
+        static constexpr std::array<size_t, tableSize> slots = [] {
+            std::array<size_t, tableSize> result{};
+
+            for (auto& slot : result) {
+                slot = count;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                result[hashes[i] % tableSize] = i;
+            }
+
+            return result;
+        }();
+
+        // Returns the index of the field with the key, or `count`
+        static size_t find(std::string_view key) {
+            size_t index = slots[hashKey(key) % tableSize];
+            return index < count && keys[index] == key ? index : count;
+        }
+    };
+
+    template<typename T>
+    struct IsVector : std::false_type { };
+
+    template<typename T>
+    struct IsVector<std::vector<T>> : std::true_type { };
+
+    template<typename T>
+    struct IsStdArray : std::false_type { };
+
+    template<typename T, size_t N>
+    struct IsStdArray<std::array<T, N>> : std::true_type { };
+
+    template<typename T>
+    struct IsKeyedVector : std::false_type { };
+
+    template<typename T>
+    struct IsKeyedVector<std::vector<std::pair<std::string, T>>> : std::true_type { };
+
+    template<typename T>
+    struct IsStringMap : std::false_type { };
+
+    template<typename T>
+    struct IsStringMap<std::unordered_map<std::string, T>> : std::true_type { };
+
+    template<typename T>
+    struct IsTupleLike : std::false_type { };
+
+    template<typename... Ts>
+    struct IsTupleLike<std::tuple<Ts...>> : std::true_type { };
+
+    template<typename T, typename U>
+    struct IsTupleLike<std::pair<T, U>> : std::true_type { };
+
+    template<typename T, typename = void>
+    struct HasFields : std::false_type { };
+
+    template<typename T>
+    struct HasFields<T, std::void_t<decltype(T::fields)>> : std::true_type { };
+
+    template<typename T, typename Binding>
+    constexpr JsonOps makeJsonOps();
+
+    template<typename T, typename Binding>
+    inline constexpr JsonOps jsonOps = makeJsonOps<T, Binding>();
+
+    template<typename T, typename Binding>
+    JsonTarget targetOf(T& value) {
+        return {&value, &jsonOps<T, Binding>};
+    }
+
+    // The targets of the elements of a tuple, by index
+    template<typename T, typename Binding, size_t... I>
+    constexpr auto tupleTargets(std::index_sequence<I...>) {
+        return std::array<JsonTarget (*)(void*), sizeof...(I)>{
+            [](void* object) {
+                auto& element = std::get<I>(*static_cast<T*>(object));
+                return targetOf<std::tuple_element_t<I, T>, Binding>(element);
+            }...
+        };
+    }
+
+    // The targets of the members of a struct bound to an array, by index
+    template<typename T, typename Binding, size_t... I>
+    constexpr auto elementTargets(std::index_sequence<I...>) {
+        return std::array<JsonTarget (*)(void*), sizeof...(I)>{
+            [](void* object) {
+                auto& member = static_cast<T*>(object)->*std::get<I>(Binding::elements);
+                return targetOf<std::remove_reference_t<decltype(member)>, void>(member);
+            }...
+        };
+    }
+
+    // The targets of the fields of a struct bound to an object, by index
+    template<typename T, typename Binding, size_t... I>
+    constexpr auto fieldTargets(std::index_sequence<I...>) {
+        return std::array<JsonTarget (*)(void*), sizeof...(I)>{
+            [](void* object) {
+                constexpr auto field = std::get<I>(Binding::fields);
+                using Field = std::decay_t<decltype(field)>;
+                auto& member = static_cast<T*>(object)->*field.member;
+                return targetOf<std::remove_reference_t<decltype(member)>, typename Field::Binding>(member);
+            }...
+        };
+    }
+
+    template<typename T, typename Binding>
+    inline constexpr JsonFields jsonFields = {
+        JsonKeys<Binding>::keys.data(),
+        JsonKeys<Binding>::count,
+        JsonKeys<Binding>::required,
+        JsonKeys<Binding>::find,
+        [](void* object, size_t index) {
+            constexpr auto targets = fieldTargets<T, Binding>(std::make_index_sequence<JsonKeys<Binding>::count>());
+            return targets[index](object);
+        }
+    };
+
+    // Whether an integer keeps its value as a T
+    template<typename T>
+    bool fitsIn(int64_t value) {
+        T converted = static_cast<T>(value);
+        return static_cast<int64_t>(converted) == value && (converted < T(0)) == (value < 0);
+    }
+
+    template<typename T, typename Binding>
+    constexpr JsonOps makeJsonOps() {
+        JsonOps ops;
+
+        if constexpr (std::is_same_v<T, bool>) {
+            ops.setBool = [](void* object, bool value) {
+                *static_cast<T*>(object) = value;
+            };
+        } else if constexpr (std::is_integral_v<T>) {
+            ops.setNumber = [](void* object, int64_t value) {
+                if (!fitsIn<T>(value)) {
+                    throw std::runtime_error("JSON integer out of range: " + std::to_string(value));
+                }
+
+                *static_cast<T*>(object) = static_cast<T>(value);
+            };
+        } else if constexpr (std::is_floating_point_v<T>) {
+            ops.setNumber = [](void* object, int64_t value) {
+                *static_cast<T*>(object) = static_cast<T>(value);
+            };
+            ops.setDouble = [](void* object, double value) {
+                if (value > std::numeric_limits<T>::max() || value < std::numeric_limits<T>::lowest()) {
+                    throw std::runtime_error("JSON number out of range: " + std::to_string(value));
+                }
+
+                *static_cast<T*>(object) = static_cast<T>(value);
+            };
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            ops.setString = [](void* object, std::string_view value) {
+                static_cast<T*>(object)->assign(value);
+            };
+        } else if constexpr (std::is_same_v<T, JsonValue>) {
+            ops.setDocument = [](void* object, JsonValue&& value) {
+                *static_cast<T*>(object) = std::move(value);
+            };
+        } else if constexpr (IsKeyedVector<T>::value) {
+            // Keeps the members in order
+            ops.member = [](void* object, std::string_view key) {
+                using Value = typename T::value_type::second_type;
+                auto& entry = static_cast<T*>(object)->emplace_back(std::string(key), Value());
+                return targetOf<Value, Binding>(entry.second);
+            };
+        } else if constexpr (IsVector<T>::value) {
+            ops.element = [](void* object, size_t) {
+                auto& element = static_cast<T*>(object)->emplace_back();
+                return targetOf<typename T::value_type, Binding>(element);
+            };
+        } else if constexpr (IsStdArray<T>::value) {
+            ops.element = [](void* object, size_t index) {
+                T& elements = *static_cast<T*>(object);
+                return index < elements.size()
+                    ? targetOf<typename T::value_type, Binding>(elements[index])
+                    : JsonTarget();
+            };
+        } else if constexpr (IsStringMap<T>::value) {
+            ops.member = [](void* object, std::string_view key) {
+                auto& value = (*static_cast<T*>(object))[std::string(key)];
+                return targetOf<typename T::mapped_type, Binding>(value);
+            };
+        } else if constexpr (IsTupleLike<T>::value && std::is_void_v<Binding>) {
+            ops.element = [](void* object, size_t index) {
+                constexpr size_t size = std::tuple_size_v<T>;
+                constexpr auto targets = tupleTargets<T, Binding>(std::make_index_sequence<size>());
+                return index < size ? targets[index](object) : JsonTarget();
+            };
+        } else {
+            using StructBinding = std::conditional_t<std::is_void_v<Binding>, JsonBinding<T>, Binding>;
+
+            if constexpr (HasFields<StructBinding>::value) {
+                ops.fields = &jsonFields<T, StructBinding>;
+            } else {
+                ops.element = [](void* object, size_t index) {
+                    constexpr size_t size = std::tuple_size_v<std::decay_t<decltype(StructBinding::elements)>>;
+                    constexpr auto targets = elementTargets<T, StructBinding>(std::make_index_sequence<size>());
+                    return index < size ? targets[index](object) : JsonTarget();
+                };
+            }
+        }
+
+        return ops;
+    }
+}
+
+/**
+ * \brief Handler that reads a value into a variable of a bound type. Extra
+ * elements are skipped; missing elements, missing optional fields and nulls
+ * leave their variables as they were. Throws std::runtime_error if an object
+ * has a key without a field or lacks the key of a field that isn't
+ * optional, or if a value doesn't have the type of its variable.
+ */
+class JsonBinder : public JsonHandler {
+    using JsonTarget = __detail::JsonTarget;
+ public:
+    template<typename T>
+    explicit JsonBinder(T& target) : next(__detail::targetOf<T, void>(target)) { }
+
+    void onStartObject();
+    void onKey(std::string_view key);
+    void onEndObject();
+    void onStartArray();
+    void onEndArray();
+    void onString(std::string_view value);
+    void onNumber(int64_t value);
+    void onDouble(double value);
+    void onBool(bool value);
+    void onNull();
+
+ private:
+    struct Container {
+        JsonTarget target;
+        // Next element, for arrays
+        size_t index;
+        // Bit i is set once field i was read, for bound structs
+        uint64_t readFields;
+    };
+
+    std::vector<Container> containers;
+    // Where the next value goes when it's a member or the whole input
+    JsonTarget next;
+    // Depth inside a value being skipped
+    int skipDepth = 0;
+    // Builds the values read as documents
+    std::optional<JsonValueBuilder> builder;
+    JsonTarget documentTarget;
+    int documentDepth = 0;
+
+    /**
+     * \brief Forwards an event to the value being skipped or built as a
+     * document, if any. `nesting` is how the event changes the depth.
+     */
+    template<typename Forward>
+    bool redirect(int nesting, Forward forward);
+    /**
+     * \brief Returns the target of a value that starts, or an empty target
+     * if the value is skipped or built as a document instead.
+     */
+    template<typename Forward>
+    JsonTarget startValue(int nesting, Forward forward);
+    void startContainer(bool array, JsonTarget target);
+
+    [[noreturn]] static void typeMismatch(const char* type) {
+        throw std::runtime_error(std::string("Unexpected JSON ") + type);
+    }
+};
+
+template<typename Forward>
+inline bool JsonBinder::redirect(int nesting, Forward forward) {
+    if (skipDepth > 0) {
+        skipDepth += nesting;
+        return true;
+    }
+
+    if (!builder) {
+        return false;
+    }
+
+    forward(*builder);
+    documentDepth += nesting;
+
+    if (documentDepth == 0) {
+        documentTarget.ops->setDocument(documentTarget.object, builder->result());
+        builder.reset();
+    }
+
+    return true;
+}
+
+template<typename Forward>
+inline JsonBinder::JsonTarget JsonBinder::startValue(int nesting, Forward forward) {
+    if (redirect(nesting, forward)) {
+        return {};
+    }
+
+    JsonTarget target = next;
+
+    if (!containers.empty() && containers.back().target.ops->element) {
+        Container& array = containers.back();
+        target = array.target.ops->element(array.target.object, array.index++);
+    }
+
+    if (!target.ops) {
+        skipDepth = nesting;
+        return {};
+    }
+
+    if (target.ops->setDocument) {
+        builder.emplace();
+        documentTarget = target;
+        redirect(nesting, forward);
+        return {};
+    }
+
+    return target;
+}
+
+inline void JsonBinder::startContainer(bool array, JsonTarget target) {
+    if (array ? !target.ops->element : !target.ops->member && !target.ops->fields) {
+        typeMismatch(array ? "array" : "object");
+    }
+
+    containers.push_back({target, 0, 0});
+}
+
+inline void JsonBinder::onStartObject() {
+    JsonTarget target = startValue(1, [](JsonValueBuilder& builder) { builder.onStartObject(); });
+
+    if (target.ops) {
+        startContainer(false, target);
+    }
+}
+
+inline void JsonBinder::onKey(std::string_view key) {
+    if (redirect(0, [&](JsonValueBuilder& builder) { builder.onKey(key); })) {
+        return;
+    }
+
+    Container& object = containers.back();
+    const __detail::JsonFields* fields = object.target.ops->fields;
+
+    if (!fields) {
+        next = object.target.ops->member(object.target.object, key);
+        return;
+    }
+
+    size_t index = fields->find(key);
+
+    if (index == fields->count) {
+        throw std::runtime_error("Unknown JSON key: " + std::string(key));
+    }
+
+    object.readFields |= uint64_t(1) << index;
+    next = fields->target(object.target.object, index);
+}
+
+inline void JsonBinder::onEndObject() {
+    if (redirect(-1, [](JsonValueBuilder& builder) { builder.onEndObject(); })) {
+        return;
+    }
+
+    const Container& object = containers.back();
+
+    if (const __detail::JsonFields* fields = object.target.ops->fields) {
+        uint64_t missing = fields->required & ~object.readFields;
+
+        for (size_t i = 0; missing != 0; ++i, missing >>= 1) {
+            if (missing & 1) {
+                throw std::runtime_error("Missing JSON key: " + std::string(fields->keys[i]));
+            }
+        }
+    }
+
+    containers.pop_back();
+}
+
+inline void JsonBinder::onStartArray() {
+    JsonTarget target = startValue(1, [](JsonValueBuilder& builder) { builder.onStartArray(); });
+
+    if (target.ops) {
+        startContainer(true, target);
+    }
+}
+
+inline void JsonBinder::onEndArray() {
+    if (!redirect(-1, [](JsonValueBuilder& builder) { builder.onEndArray(); })) {
+        containers.pop_back();
+    }
+}
+
+inline void JsonBinder::onString(std::string_view value) {
+    JsonTarget target = startValue(0, [&](JsonValueBuilder& builder) { builder.onString(value); });
+
+    if (target.ops) {
+        if (!target.ops->setString) {
+            typeMismatch("string");
+        }
+
+        target.ops->setString(target.object, value);
+    }
+}
+
+inline void JsonBinder::onNumber(int64_t value) {
+    JsonTarget target = startValue(0, [&](JsonValueBuilder& builder) { builder.onNumber(value); });
+
+    if (target.ops) {
+        if (!target.ops->setNumber) {
+            typeMismatch("integer");
+        }
+
+        target.ops->setNumber(target.object, value);
+    }
+}
+
+inline void JsonBinder::onDouble(double value) {
+    JsonTarget target = startValue(0, [&](JsonValueBuilder& builder) { builder.onDouble(value); });
+
+    if (target.ops) {
+        if (!target.ops->setDouble) {
+            typeMismatch("number");
+        }
+
+        target.ops->setDouble(target.object, value);
+    }
+}
+
+inline void JsonBinder::onBool(bool value) {
+    JsonTarget target = startValue(0, [&](JsonValueBuilder& builder) { builder.onBool(value); });
+
+    if (target.ops) {
+        if (!target.ops->setBool) {
+            typeMismatch("boolean");
+        }
+
+        target.ops->setBool(target.object, value);
+    }
+}
+
+inline void JsonBinder::onNull() {
+    startValue(0, [](JsonValueBuilder& builder) { builder.onNull(); });
+}
+
+/**
+ * \brief Reads JSON text into a variable of a bound type, without building
+ * a document.
+ */
+template<typename T>
+void bindJSON(std::string_view input, T& target) {
+    JsonBinder binder(target);
+    readJSON(input, binder);
+}
+
+/**
+ * \brief Reads a parsed JSON value into a variable of a bound type.
+ */
+template<typename T>
+void bindJSON(const JsonValue& value, T& target) {
+    JsonBinder binder(target);
+    readJSON(value, binder);
+}
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef JSON_READER_HPP
+#define JSON_READER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "JsonValue.hpp"
+#include "Scanner.hpp"
+
+/**
+ * \brief Base of the handlers given to readJSON(), ignoring every event.
+ * Handlers hide the methods of the events they need; they're called
+ * statically, so these aren't virtual.
+ *
+ * Strings and keys are only valid during the call that receives them.
+ * Numbers without a fraction or exponent that fit in 64 bits are integers,
+ * except -0; all others are doubles.
+ */
+struct JsonHandler {
+    void onStartObject() { }
+    void onKey(std::string_view) { }
+    void onEndObject() { }
+    void onStartArray() { }
+    void onEndArray() { }
+    void onString(std::string_view) { }
+    void onNumber(int64_t) { }
+    void onDouble(double) { }
+    void onBool(bool) { }
+    void onNull() { }
+};
+
+namespace __detail {
+    inline std::runtime_error unexpectedToken(const Token& token) {
+        if (token.kind == TokenKind::EndOfFile) {
+            return std::runtime_error("Unexpected end of input");
+        }
+
+        return std::runtime_error("Unexpected token " + tokenToString(token));
+    }
+
+    inline void expectToken(TokenKind kind, const Token& token) {
+        if (token.kind != kind) {
+            throw std::runtime_error(
+                "Expected " + tokenKindToString(kind) + ", got "
+                + (token.kind == TokenKind::EndOfFile ? "end of input" : tokenToString(token))
+            );
+        }
+    }
+
+    /**
+     * \brief Whether a number literal out of the range of doubles is too
+     * large rather than too close to zero, from the power of ten of its
+     * first significant digit.
+     */
+    inline bool isTooLarge(std::string_view text) {
+        size_t exponentStart = text.find_first_of("eE");
+        size_t mantissaEnd = exponentStart == std::string_view::npos ? text.size() : exponentStart;
+        size_t point = std::min(text.find('.'), mantissaEnd);
+        size_t first = text.find_first_not_of("-0.");
+
+        if (first >= mantissaEnd) {
+            return false;
+        }
+
+        int64_t power = first < point
+            ? static_cast<int64_t>(point - first - 1)
+            : -static_cast<int64_t>(first - point);
+        int64_t exponent = 0;
+
+        if (exponentStart != std::string_view::npos) {
+            const char* digits = text.data() + exponentStart + 1;
+            digits += (*digits == '+');
+            auto [digitsEnd, error] = std::from_chars(digits, text.data() + text.size(), exponent);
+
+            // Exponents beyond 64 bits only have a sign that matters
+            if (error != std::errc()) {
+                return *digits != '-';
+            }
+        }
+
+        return exponent > -power;
+    }
+
+    /**
+     * \brief Sends a number literal to the handler. Most numbers are
+     * integers, so they're tried first; doubles are rounded correctly.
+     * Numbers too close to zero for a double read as zero, and those too
+     * large throw.
+     */
+    template<typename Handler>
+    void readNumber(std::string_view text, Handler& handler) {
+        const char* end = text.data() + text.size();
+        int64_t integer = 0;
+        auto [integerEnd, integerError] = std::from_chars(text.data(), end, integer);
+
+        // -0 is kept as a double, which has a sign
+        if (integerError == std::errc() && integerEnd == end && (integer != 0 || text[0] != '-')) {
+            handler.onNumber(integer);
+            return;
+        }
+
+        double number = 0;
+        auto [numberEnd, numberError] = std::from_chars(text.data(), end, number);
+
+        if (numberError == std::errc::result_out_of_range && numberEnd == end) {
+            if (isTooLarge(text)) {
+                throw std::runtime_error("Number out of range: " + std::string(text));
+            }
+
+            number = text[0] == '-' ? -0.0 : 0.0;
+        } else if (numberError != std::errc() || numberEnd != end) {
+            throw std::runtime_error("Invalid number: " + std::string(text));
+        }
+
+        handler.onDouble(number);
+    }
+
+    // Escape sequences are only decoded when a string has any
+    inline std::string_view decodeString(const Token& token, std::string& buffer) {
+        if (token.escaped) {
+            JsonScanner::unescape(token.text, buffer);
+            return buffer;
+        }
+
+        return token.text;
+    }
+}
+
+/**
+ * \brief Reads a JSON document held in memory, calling the handler for each
+ * value, key, and start and end of a container, in order. Nothing is built
+ * in between, so the memory used doesn't depend on the size of the input.
+ * Throws std::runtime_error if the document is malformed or anything but
+ * whitespace and comments follows its root value. The handler may have
+ * been called for part of the document by then.
+ */
+template<typename Handler>
+void readJSON(std::string_view input, Handler& handler) {
+    using __detail::expectToken;
+
+    enum class State {
+        Value,
+        FirstElement,
+        NextElement,
+        FirstMember,
+        NextMember
+    };
+
+    JsonScanner scanner(input);
+    std::string buffer;
+    // Whether each open container is an array, innermost last
+    std::vector<bool> containers;
+    State state = State::Value;
+
+    while (true) {
+        Token token = scanner.scan();
+
+        if (state == State::FirstMember || state == State::NextMember) {
+            if (token.kind == TokenKind::CloseBrace) {
+                containers.pop_back();
+                handler.onEndObject();
+            } else {
+                if (state == State::NextMember) {
+                    expectToken(TokenKind::Comma, token);
+                    token = scanner.scan();
+                }
+
+                expectToken(TokenKind::StringLiteral, token);
+                handler.onKey(__detail::decodeString(token, buffer));
+                expectToken(TokenKind::Colon, scanner.scan());
+                state = State::Value;
+                continue;
+            }
+        } else if ((state == State::FirstElement || state == State::NextElement)
+                   && token.kind == TokenKind::CloseBracket) {
+            containers.pop_back();
+            handler.onEndArray();
+        } else {
+            if (state == State::NextElement) {
+                expectToken(TokenKind::Comma, token);
+                token = scanner.scan();
+            }
+
+            switch (token.kind) {
+                case TokenKind::StringLiteral:
+                    handler.onString(__detail::decodeString(token, buffer));
+                    break;
+                case TokenKind::NumberLiteral:
+                    __detail::readNumber(token.text, handler);
+                    break;
+                case TokenKind::BooleanLiteral:
+                    handler.onBool(token.text == "true");
+                    break;
+                case TokenKind::NullLiteral:
+                    handler.onNull();
+                    break;
+                case TokenKind::OpenBracket:
+                    containers.push_back(true);
+                    handler.onStartArray();
+                    state = State::FirstElement;
+                    continue;
+                case TokenKind::OpenBrace:
+                    containers.push_back(false);
+                    handler.onStartObject();
+                    state = State::FirstMember;
+                    continue;
+                default:
+                    throw __detail::unexpectedToken(token);
+            }
+        }
+
+        // A value was completed. Only whitespace and comments can follow
+        // the root.
+        if (containers.empty()) {
+            expectToken(TokenKind::EndOfFile, scanner.scan());
+            return;
+        }
+
+        state = containers.back() ? State::NextElement : State::NextMember;
+    }
+}
+
+/**
+ * \brief Calls the handler with the events of an already parsed value, as
+ * readJSON() would for its text. Lets the same handler read files and
+ * parts of documents.
+ */
+template<typename Handler>
+void readJSON(const JsonValue& value, Handler& handler) {
+    switch (value.type()) {
+        case JsonValue::Type::Null:
+            handler.onNull();
+            break;
+        case JsonValue::Type::Boolean:
+            handler.onBool(value.asBool());
+            break;
+        case JsonValue::Type::Integer:
+            handler.onNumber(value.asInt64());
+            break;
+        case JsonValue::Type::Double:
+            handler.onDouble(value.asDouble());
+            break;
+        case JsonValue::Type::String:
+            handler.onString(value.asStringView());
+            break;
+        case JsonValue::Type::Array:
+            handler.onStartArray();
+
+            for (const auto& element : value.asIterableArray()) {
+                readJSON(element, handler);
+            }
+
+            handler.onEndArray();
+            break;
+        case JsonValue::Type::Object:
+            handler.onStartObject();
+
+            for (const auto& [key, member] : value.asIterableMap()) {
+                handler.onKey(key);
+                readJSON(member, handler);
+            }
+
+            handler.onEndObject();
+            break;
+        default:
+            break;
+    }
+}
+
+#endif
@@ -1,166 +1,482 @@
 #ifndef JSON_VALUE_HPP
 #define JSON_VALUE_HPP
 
-#include <iostream>
-#include <memory>
-#include <typeindex>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
-#include "Scanner.hpp"
+#include "JsonArena.hpp"
 
 class JsonValue;
+class JsonValueBuilder;
+struct JsonMember;
 
 namespace __detail {
     using Array = std::vector<JsonValue>;
     using Map = std::unordered_map<std::string, JsonValue>;
 
-    template<typename T>
-    class JsonIteratorWrapper {
+    class JsonArrayRange {
      public:
-        using iterator = typename T::iterator;
-        using const_iterator = typename T::const_iterator;
+        using const_iterator = const JsonValue*;
+        using iterator = const_iterator;
 
-        JsonIteratorWrapper(const JsonValue&);
+        JsonArrayRange(const JsonValue* elements, size_t elementCount)
+         : elements(elements), elementCount(elementCount) { }
 
-        iterator begin();
-        const_iterator begin() const;
-        const_iterator cbegin() const;
-        iterator end();
+        const_iterator begin() const { return elements; }
+        const_iterator cbegin() const { return elements; }
         const_iterator end() const;
         const_iterator cend() const;
+        size_t size() const { return elementCount; }
+        bool empty() const { return elementCount == 0; }
+
+        const JsonValue& operator[](size_t index) const;
+        const JsonValue& at(size_t index) const;
 
      private:
-        const JsonValue& value;
+        const JsonValue* elements;
+        size_t elementCount;
     };
-}
 
-using JsonArrayIterator = __detail::JsonIteratorWrapper<__detail::Array>;
-using JsonMapIterator = __detail::JsonIteratorWrapper<__detail::Map>;
+    class JsonMapRange {
+     public:
+        using const_iterator = const JsonMember*;
+        using iterator = const_iterator;
+
+        JsonMapRange(const JsonMember* members, size_t memberCount)
+         : members(members), memberCount(memberCount) { }
+
+        const_iterator begin() const { return members; }
+        const_iterator cbegin() const { return members; }
+        const_iterator end() const;
+        const_iterator cend() const;
+        size_t size() const { return memberCount; }
+        bool empty() const { return memberCount == 0; }
+
+        // Objects are small, so members are searched linearly
+        const JsonValue* find(std::string_view key) const;
+        size_t count(std::string_view key) const;
+        const JsonValue& operator[](std::string_view key) const;
+        const JsonValue& at(std::string_view key) const;
 
+     private:
+        const JsonMember* members;
+        size_t memberCount;
+    };
+}
+
+using JsonArrayIterator = __detail::JsonArrayRange;
+using JsonMapIterator = __detail::JsonMapRange;
+
+/**
+ * \brief A JSON value: a discriminated union of null, a boolean, a 64-bit
+ * integer, a double, a string, an array or an object.
+ *
+ * The nodes and strings of a parsed document live in a JsonArena, and the
+ * value returned by the parser owns it, so the whole document is freed at
+ * once. Copying that value shares the arena; copying any other value that
+ * has children copies them into an arena of its own. Values inside a
+ * document can't be modified.
+ */
 class JsonValue {
     using Array = __detail::Array;
     using Map = __detail::Map;
  public:
-    JsonValue();
+    enum class Type : uint8_t {
+        Empty,
+        Null,
+        Boolean,
+        Integer,
+        Double,
+        String,
+        Array,
+        Object
+    };
 
-    template<typename T>
-    JsonValue(const T&);
+    JsonValue();
+    JsonValue(std::nullptr_t);
+    JsonValue(bool);
+    JsonValue(int);
+    JsonValue(int64_t);
+    JsonValue(double);
+    JsonValue(const char*);
+    JsonValue(std::string_view);
+    JsonValue(const std::string&);
+    JsonValue(const Array&);
+    JsonValue(const Map&);
+
+    JsonValue(const JsonValue&);
+    JsonValue(JsonValue&&) noexcept;
+    JsonValue& operator=(JsonValue) noexcept;
+    ~JsonValue();
+
+    Type type() const {
+        return valueType;
+    }
 
+    /**
+     * \brief Checks the type of the value. T is one of std::nullptr_t,
+     * bool, int or int64_t (integers), double, std::string,
+     * std::vector<JsonValue> and std::unordered_map<std::string, JsonValue>.
+     */
     template<typename T>
     bool is() const;
 
+    /**
+     * \brief Returns the value as T, which must be its type. Strings are
+     * copied; arrays and objects are returned as ranges over the document.
+     */
     template<typename T>
-    T& get() const;
-    int& asInt() const;
-    std::string& asString() const;
-
-    JsonArrayIterator asIterableArray() const {
-        return *this;
-    }
-
-    JsonMapIterator asIterableMap() const {
-        return *this;
-    }
+    auto get() const;
+    bool asBool() const;
+    int asInt() const;
+    int64_t asInt64() const;
+    // Integers are converted
+    double asDouble() const;
+    std::string asString() const;
+    std::string_view asStringView() const;
+
+    JsonArrayIterator asIterableArray() const;
+    JsonMapIterator asIterableMap() const;
 
     // Array access
-    JsonValue& operator[](int index);
     const JsonValue& operator[](int index) const;
-    JsonValue& at(int index);
     const JsonValue& at(int index) const;
 
     // Map access
-    JsonValue& operator[](const std::string& key);
-    const JsonValue& operator[](const std::string& key) const;
-    JsonValue& at(const std::string& key);
-    const JsonValue& at(const std::string& key) const;
+    const JsonValue& operator[](std::string_view key) const;
+    const JsonValue& at(std::string_view key) const;
 
  private:
-    std::type_index type;
-    std::shared_ptr<void> value;
+    friend class JsonValueBuilder;
+
+    union Payload {
+        bool boolean;
+        int64_t integer;
+        double number;
+        const char* string;
+        const JsonValue* elements;
+        const JsonMember* members;
+    };
+
+    Type valueType = Type::Empty;
+    // Number of characters, elements or members
+    uint32_t length = 0;
+    Payload payload = {};
+    // Set on the values that own their document
+    JsonArena* arena = nullptr;
+
+    template<typename T>
+    static constexpr Type typeOf();
+
+    // Copies the node itself, sharing its children
+    void copyNode(const JsonValue&);
+    // Copies the node and all its children into an arena
+    static void copyTree(JsonValue& target, const JsonValue& source, JsonArena&);
+    void ownCopyOf(const JsonValue&);
 };
 
-inline JsonValue::JsonValue() : type(typeid(void)) { }
+/**
+ * \brief A member of a JSON object. Its key lives in the same arena.
+ */
+struct JsonMember {
+    std::string_view key;
+    JsonValue value;
+};
+
+inline JsonValue::JsonValue() = default;
+
+inline JsonValue::JsonValue(std::nullptr_t) : valueType(Type::Null) { }
+
+inline JsonValue::JsonValue(bool value) : valueType(Type::Boolean) {
+    payload.boolean = value;
+}
+
+inline JsonValue::JsonValue(int value) : JsonValue(static_cast<int64_t>(value)) { }
+
+inline JsonValue::JsonValue(int64_t value) : valueType(Type::Integer) {
+    payload.integer = value;
+}
+
+inline JsonValue::JsonValue(double value) : valueType(Type::Double) {
+    payload.number = value;
+}
+
+inline JsonValue::JsonValue(const char* value) : JsonValue(std::string_view(value)) { }
+
+inline JsonValue::JsonValue(std::string_view value) {
+    JsonValue node;
+    node.valueType = Type::String;
+    node.length = static_cast<uint32_t>(value.size());
+    node.payload.string = value.data();
+    ownCopyOf(node);
+}
+
+inline JsonValue::JsonValue(const std::string& value) : JsonValue(std::string_view(value)) { }
 
-template <typename T>
-inline JsonValue::JsonValue(const T& value) : type(typeid(T)), value(new T(value)) { }
+inline JsonValue::JsonValue(const Array& values) {
+    JsonValue node;
+    node.valueType = Type::Array;
+    node.length = static_cast<uint32_t>(values.size());
+    node.payload.elements = values.data();
+    ownCopyOf(node);
+}
+
+inline JsonValue::JsonValue(const Map& values) {
+    std::vector<JsonMember> members;
+    members.reserve(values.size());
+
+    // The members only borrow the keys and children until they're copied
+    for (const auto& [key, value] : values) {
+        members.push_back({key, JsonValue()});
+        members.back().value.copyNode(value);
+    }
+
+    JsonValue node;
+    node.valueType = Type::Object;
+    node.length = static_cast<uint32_t>(members.size());
+    node.payload.members = members.data();
+    ownCopyOf(node);
+}
+
+inline JsonValue::JsonValue(const JsonValue& other) {
+    if (other.arena) {
+        copyNode(other);
+        arena = other.arena;
+        arena->addReference();
+    } else {
+        ownCopyOf(other);
+    }
+}
+
+inline JsonValue::JsonValue(JsonValue&& other) noexcept
+ : valueType(other.valueType), length(other.length), payload(other.payload), arena(other.arena) {
+    other.valueType = Type::Empty;
+    other.length = 0;
+    other.arena = nullptr;
+}
+
+inline JsonValue& JsonValue::operator=(JsonValue other) noexcept {
+    std::swap(valueType, other.valueType);
+    std::swap(length, other.length);
+    std::swap(payload, other.payload);
+    std::swap(arena, other.arena);
+    return *this;
+}
+
+inline JsonValue::~JsonValue() {
+    if (arena && arena->removeReference()) {
+        delete arena;
+    }
+}
+
+template<typename T>
+inline constexpr JsonValue::Type JsonValue::typeOf() {
+    if constexpr (std::is_same_v<T, std::nullptr_t>) {
+        return Type::Null;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return Type::Boolean;
+    } else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int64_t>) {
+        return Type::Integer;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return Type::Double;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return Type::String;
+    } else if constexpr (std::is_same_v<T, Array>) {
+        return Type::Array;
+    } else {
+        static_assert(std::is_same_v<T, Map>, "Not a JSON type");
+        return Type::Object;
+    }
+}
 
 template<typename T>
 inline bool JsonValue::is() const {
-    return type == typeid(T);
+    return valueType == typeOf<T>();
 }
 
 template<typename T>
-inline T& JsonValue::get() const {
-    return *static_cast<T*>(value.get());
+inline auto JsonValue::get() const {
+    assert(is<T>());
+
+    if constexpr (std::is_same_v<T, std::nullptr_t>) {
+        return nullptr;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return payload.boolean;
+    } else if constexpr (std::is_same_v<T, int>) {
+        return static_cast<int>(payload.integer);
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return payload.integer;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return payload.number;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return asString();
+    } else if constexpr (std::is_same_v<T, Array>) {
+        return asIterableArray();
+    } else {
+        return asIterableMap();
+    }
+}
+
+inline bool JsonValue::asBool() const {
+    return get<bool>();
 }
 
-inline int& JsonValue::asInt() const {
+inline int JsonValue::asInt() const {
     return get<int>();
 }
 
-inline std::string& JsonValue::asString() const {
-    return get<std::string>();
+inline int64_t JsonValue::asInt64() const {
+    return get<int64_t>();
 }
 
-inline JsonValue& JsonValue::operator[](const std::string& key) {
-    return get<Map>().at(key);
+inline double JsonValue::asDouble() const {
+    if (valueType == Type::Integer) {
+        return static_cast<double>(payload.integer);
+    }
+
+    return get<double>();
 }
 
-inline const JsonValue& JsonValue::operator[](const std::string& key) const {
-    return get<Map>().at(key);
+inline std::string JsonValue::asString() const {
+    return std::string(asStringView());
 }
 
-inline JsonValue& JsonValue::at(const std::string& key) {
-    return get<Map>().at(key);
+inline std::string_view JsonValue::asStringView() const {
+    assert(valueType == Type::String);
+    return {payload.string, length};
 }
 
-inline const JsonValue& JsonValue::at(const std::string& key) const {
-    return get<Map>().at(key);
+inline JsonArrayIterator JsonValue::asIterableArray() const {
+    assert(valueType == Type::Array);
+    return {payload.elements, length};
 }
 
-inline JsonValue& JsonValue::operator[](int index) {
-    return get<Array>().at(index);
+inline JsonMapIterator JsonValue::asIterableMap() const {
+    assert(valueType == Type::Object);
+    return {payload.members, length};
 }
 
-inline const JsonValue& JsonValue::operator[](int index) const {
-    return get<Array>().at(index);
+inline const JsonValue& JsonValue::operator[](std::string_view key) const {
+    return asIterableMap().at(key);
 }
 
-inline JsonValue& JsonValue::at(int index) {
-    return get<Array>().at(index);
+inline const JsonValue& JsonValue::at(std::string_view key) const {
+    return asIterableMap().at(key);
+}
+
+inline const JsonValue& JsonValue::operator[](int index) const {
+    return asIterableArray().at(index);
 }
 
 inline const JsonValue& JsonValue::at(int index) const {
-    return get<Array>().at(index);
+    return asIterableArray().at(index);
+}
+
+inline void JsonValue::copyNode(const JsonValue& other) {
+    valueType = other.valueType;
+    length = other.length;
+    payload = other.payload;
+}
+
+inline void JsonValue::copyTree(JsonValue& target, const JsonValue& source, JsonArena& arena) {
+    target.copyNode(source);
+
+    if (source.valueType == Type::String) {
+        target.payload.string = arena.copyString(source.asStringView()).data();
+    } else if (source.valueType == Type::Array) {
+        JsonValue* elements = arena.allocateArray<JsonValue>(source.length);
+
+        for (uint32_t i = 0; i < source.length; ++i) {
+            copyTree(*new (elements + i) JsonValue(), source.payload.elements[i], arena);
+        }
+
+        target.payload.elements = elements;
+    } else if (source.valueType == Type::Object) {
+        JsonMember* members = arena.allocateArray<JsonMember>(source.length);
+
+        for (uint32_t i = 0; i < source.length; ++i) {
+            const JsonMember& member = source.payload.members[i];
+            new (members + i) JsonMember{arena.copyString(member.key), JsonValue()};
+            copyTree(members[i].value, member.value, arena);
+        }
+
+        target.payload.members = members;
+    }
+}
+
+inline void JsonValue::ownCopyOf(const JsonValue& other) {
+    bool hasChildren = other.valueType == Type::String
+        || ((other.valueType == Type::Array || other.valueType == Type::Object) && other.length > 0);
+
+    if (hasChildren) {
+        arena = new JsonArena();
+        copyTree(*this, other, *arena);
+    } else {
+        copyNode(other);
+    }
 }
 
 namespace __detail {
-    template<typename T>
-    inline JsonIteratorWrapper<T>::JsonIteratorWrapper(const JsonValue& value) : value(value) { }
+    inline JsonArrayRange::const_iterator JsonArrayRange::end() const {
+        return elements + elementCount;
+    }
 
-    template<typename T>
-    inline typename JsonIteratorWrapper<T>::iterator
-    JsonIteratorWrapper<T>::begin() { return value.get<T>().begin(); }
+    inline JsonArrayRange::const_iterator JsonArrayRange::cend() const {
+        return end();
+    }
 
-    template<typename T>
-    inline typename JsonIteratorWrapper<T>::const_iterator
-    JsonIteratorWrapper<T>::begin() const { return value.get<T>().cbegin(); }
+    inline const JsonValue& JsonArrayRange::operator[](size_t index) const {
+        return at(index);
+    }
 
-    template<typename T>
-    inline typename JsonIteratorWrapper<T>::const_iterator
-    JsonIteratorWrapper<T>::cbegin() const { return value.get<T>().begin(); }
+    inline const JsonValue& JsonArrayRange::at(size_t index) const {
+        if (index >= elementCount) {
+            throw std::out_of_range("JSON array index out of range: " + std::to_string(index));
+        }
 
-    template<typename T>
-    inline typename JsonIteratorWrapper<T>::iterator
-    JsonIteratorWrapper<T>::end() { return value.get<T>().end(); }
+        return elements[index];
+    }
 
-    template<typename T>
-    inline typename JsonIteratorWrapper<T>::const_iterator
-    JsonIteratorWrapper<T>::end() const { return value.get<T>().cend(); }
+    inline JsonMapRange::const_iterator JsonMapRange::end() const {
+        return members + memberCount;
+    }
 
-    template<typename T>
-    inline typename JsonIteratorWrapper<T>::const_iterator
-    JsonIteratorWrapper<T>::cend() const { return value.get<T>().end(); }
+    inline JsonMapRange::const_iterator JsonMapRange::cend() const {
+        return end();
+    }
+
+    inline const JsonValue* JsonMapRange::find(std::string_view key) const {
+        for (size_t i = 0; i < memberCount; ++i) {
+            if (members[i].key == key) {
+                return &members[i].value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline size_t JsonMapRange::count(std::string_view key) const {
+        return find(key) ? 1 : 0;
+    }
+
+    inline const JsonValue& JsonMapRange::operator[](std::string_view key) const {
+        return at(key);
+    }
+
+    inline const JsonValue& JsonMapRange::at(std::string_view key) const {
+        if (const JsonValue* value = find(key)) {
+            return *value;
+        }
+
+        throw std::out_of_range("JSON object has no member: " + std::string(key));
+    }
 }
 
 #endif
@@ -1,140 +1,315 @@
 #ifndef JSON_SCANNER_HPP
 #define JSON_SCANNER_HPP
 
-#include <cassert>
-#include <istream>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include "Token.hpp"
 
+/**
+ * \brief Splits a JSON document held in memory into tokens. Tokens point
+ * into the document instead of copying it, so it must outlive them.
+ */
 class JsonScanner {
  public:
-    void setInputStream(std::istream&);
+    JsonScanner() = default;
+    explicit JsonScanner(std::string_view input);
+
+    void setInput(std::string_view input);
     bool eof() const;
     Token scan();
 
+    /**
+     * \brief Decodes the escape sequences of the text of a string literal.
+     * Throws std::runtime_error if one is invalid.
+     */
+    static std::string unescape(std::string_view text);
+
+    /**
+     * \brief Same as above, reusing the capacity of `result`.
+     */
+    static void unescape(std::string_view text, std::string& result);
+
  private:
-    std::istream* stream;
-    char currentChar = 0;
+    const char* current = nullptr;
+    const char* end = nullptr;
 
     void skipComment();
     Token scanStringLiteral();
-    Token scanNumberLiteral(char firstChar);
-    Token scanExactly(const std::string& content, TokenKind);
+    Token scanNumberLiteral();
+    Token scanExactly(std::string_view content, TokenKind);
 };
 
-inline void JsonScanner::setInputStream(std::istream& inputStream) {
-    stream = &inputStream;
-    currentChar = 0;
+inline JsonScanner::JsonScanner(std::string_view input) {
+    setInput(input);
+}
+
+inline void JsonScanner::setInput(std::string_view input) {
+    current = input.data();
+    end = input.data() + input.size();
 }
 
 inline bool JsonScanner::eof() const {
-    return stream->eof();
+    return current == end;
 }
 
 inline Token JsonScanner::scan() {
-    char ch = currentChar == 0 ? stream->get() : currentChar;
-    currentChar = 0;
-    constexpr auto eof = std::char_traits<char>::eof();
-
-    switch (ch) {
-        case eof:
-            return {TokenKind::EndOfFile, ""};
-        case ' ':
-        case '\t':
-        case '\n':
-            return scan();
-        case '/':
-            skipComment();
-            return scan();
-        case '"':
-            return scanStringLiteral();
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-        case '-':
-            return scanNumberLiteral(ch);
-        case 't':
-            return scanExactly("true", TokenKind::BooleanLiteral);
-        case 'f':
-            return scanExactly("false", TokenKind::BooleanLiteral);
-        case 'n':
-            return scanExactly("null", TokenKind::NullLiteral);
-        case '[':
-            return {TokenKind::OpenBracket, "["};
-        case ']':
-            return {TokenKind::CloseBracket, "]"};
-        case '{':
-            return {TokenKind::OpenBrace, "{"};
-        case '}':
-            return {TokenKind::CloseBrace, "}"};
-        case ':':
-            return {TokenKind::Colon, ":"};
-        case ',':
-            return {TokenKind::Comma, ","};
-        default:
-            throw std::runtime_error("Invalid character: " + std::to_string(ch));
+    while (current != end) {
+        const char* start = current;
+
+        switch (*current++) {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                continue;
+            case '/':
+                skipComment();
+                continue;
+            case '"':
+                return scanStringLiteral();
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '-':
+                current = start;
+                return scanNumberLiteral();
+            case 't':
+                current = start;
+                return scanExactly("true", TokenKind::BooleanLiteral);
+            case 'f':
+                current = start;
+                return scanExactly("false", TokenKind::BooleanLiteral);
+            case 'n':
+                current = start;
+                return scanExactly("null", TokenKind::NullLiteral);
+            case '[':
+                return {TokenKind::OpenBracket, {start, 1}};
+            case ']':
+                return {TokenKind::CloseBracket, {start, 1}};
+            case '{':
+                return {TokenKind::OpenBrace, {start, 1}};
+            case '}':
+                return {TokenKind::CloseBrace, {start, 1}};
+            case ':':
+                return {TokenKind::Colon, {start, 1}};
+            case ',':
+                return {TokenKind::Comma, {start, 1}};
+            default:
+                throw std::runtime_error("Invalid character: " + std::to_string(*start));
+        }
     }
+
+    return {TokenKind::EndOfFile, {}};
 }
 
 inline void JsonScanner::skipComment() {
-    char ch = stream->get();
+    char ch = current != end ? *current++ : 0;
 
     if (ch == '/') {
-        while (stream->get() != '\n');
+        while (current != end && *current++ != '\n');
         return;
     }
 
     if (ch == '*') {
-        while (stream->get() != '*' || stream->get() != '/');
-        return;
+        while (current != end) {
+            if (*current++ == '*' && current != end && *current == '/') {
+                ++current;
+                return;
+            }
+        }
+
+        throw std::runtime_error("Unterminated comment");
     }
 
-    assert(false);
+    throw std::runtime_error("Invalid comment, expected // or /*");
 }
 
 inline Token JsonScanner::scanStringLiteral() {
-    std::stringstream ss;
-    char ch = stream->get();
+    const char* start = current;
+    bool escaped = false;
+
+    while (current != end && *current != '"') {
+        if (*current == '\\') {
+            escaped = true;
+            // The escaped character can't end the literal
+            current += (current + 1 != end);
+        }
+
+        ++current;
+    }
 
-    while (ch != '"') {
-        ss << ch;
-        ch = stream->get();
+    if (current == end) {
+        throw std::runtime_error("Unterminated string literal");
     }
 
-    return {TokenKind::StringLiteral, ss.str()};
+    std::string_view text(start, current - start);
+    ++current;
+    return {TokenKind::StringLiteral, text, escaped};
 }
 
-inline Token JsonScanner::scanNumberLiteral(char ch) {
-    std::stringstream ss;
+inline Token JsonScanner::scanNumberLiteral() {
+    const char* start = current;
 
-    do {
-        ss << ch;
-        ch = stream->get();
-    } while (ch >= '0' && ch <= '9');
+    auto isDigit = [this] {
+        return current != end && *current >= '0' && *current <= '9';
+    };
 
-    currentChar = ch;
-    return {TokenKind::NumberLiteral, ss.str()};
-}
+    // Skips one or more digits
+    auto scanDigits = [&] {
+        if (!isDigit()) {
+            throw std::runtime_error("Invalid number literal: " + std::string(start, current));
+        }
+
+        while (isDigit()) {
+            ++current;
+        }
+    };
+
+    if (*current == '-') {
+        ++current;
+    }
 
-inline Token JsonScanner::scanExactly(const std::string& content, TokenKind tokenKind) {
-    for (size_t i = 1; i < content.size(); ++i) {
-        char ch = stream->get();
+    // The integer part can't have leading zeros
+    if (current != end && *current == '0' && current + 1 != end
+        && current[1] >= '0' && current[1] <= '9') {
+        throw std::runtime_error("Invalid number literal, leading zero: " + std::string(start, current + 2));
+    }
+
+    scanDigits();
+
+    if (current != end && *current == '.') {
+        ++current;
+        scanDigits();
+    }
 
-        if (ch != content[i]) {
-            throw std::runtime_error("Invalid character: " + std::to_string(ch));
+    if (current != end && (*current == 'e' || *current == 'E')) {
+        ++current;
+
+        if (current != end && (*current == '+' || *current == '-')) {
+            ++current;
         }
+
+        scanDigits();
     }
 
-    return {tokenKind, content};
+    return {TokenKind::NumberLiteral, {start, static_cast<size_t>(current - start)}};
+}
+
+inline Token JsonScanner::scanExactly(std::string_view content, TokenKind tokenKind) {
+    if (static_cast<size_t>(end - current) < content.size()
+        || std::string_view(current, content.size()) != content) {
+        throw std::runtime_error("Invalid literal, expected " + std::string(content));
+    }
+
+    std::string_view text(current, content.size());
+    current += content.size();
+    return {tokenKind, text};
+}
+
+inline std::string JsonScanner::unescape(std::string_view text) {
+    std::string result;
+    unescape(text, result);
+    return result;
+}
+
+inline void JsonScanner::unescape(std::string_view text, std::string& result) {
+    result.clear();
+    result.reserve(text.size());
+
+    auto readHex = [&](size_t& i) {
+        if (text.size() - i < 4) {
+            throw std::runtime_error("Invalid unicode escape sequence");
+        }
+
+        unsigned value = 0;
+
+        for (size_t end = i + 4; i < end; ++i) {
+            char ch = text[i];
+            value <<= 4;
+
+            if (ch >= '0' && ch <= '9') {
+                value |= ch - '0';
+            } else if (ch >= 'a' && ch <= 'f') {
+                value |= ch - 'a' + 10;
+            } else if (ch >= 'A' && ch <= 'F') {
+                value |= ch - 'A' + 10;
+            } else {
+                throw std::runtime_error("Invalid unicode escape sequence");
+            }
+        }
+
+        return value;
+    };
+
+    for (size_t i = 0; i < text.size(); ) {
+        if (text[i] != '\\') {
+            result += text[i++];
+            continue;
+        }
+
+        if (i + 1 == text.size()) {
+            throw std::runtime_error("Invalid escape sequence");
+        }
+
+        char ch = text[i + 1];
+        i += 2;
+
+        switch (ch) {
+            case '"': result += '"'; break;
+            case '\\': result += '\\'; break;
+            case '/': result += '/'; break;
+            case 'b': result += '\b'; break;
+            case 'f': result += '\f'; break;
+            case 'n': result += '\n'; break;
+            case 'r': result += '\r'; break;
+            case 't': result += '\t'; break;
+            case 'u': {
+                unsigned codePoint = readHex(i);
+
+                // Characters outside of the BMP are written as surrogate pairs
+                if (codePoint >= 0xD800 && codePoint < 0xDC00
+                    && text.substr(i, 2) == "\\u") {
+                    i += 2;
+                    unsigned low = readHex(i);
+
+                    if (low < 0xDC00 || low >= 0xE000) {
+                        throw std::runtime_error("Invalid unicode escape sequence");
+                    }
+
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+
+                // Encoded as UTF-8
+                if (codePoint < 0x80) {
+                    result += static_cast<char>(codePoint);
+                } else if (codePoint < 0x800) {
+                    result += static_cast<char>(0xC0 | (codePoint >> 6));
+                    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+                } else if (codePoint < 0x10000) {
+                    result += static_cast<char>(0xE0 | (codePoint >> 12));
+                    result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+                } else {
+                    result += static_cast<char>(0xF0 | (codePoint >> 18));
+                    result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                    result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    result += static_cast<char>(0x80 | (codePoint & 0x3F));
+                }
+
+                break;
+            }
+            default:
+                throw std::runtime_error("Invalid escape sequence: \\" + std::string(1, ch));
+        }
+    }
 }
 
 #endif
@@ -2,6 +2,7 @@
 #define JSON_TOKEN_HPP
 
 #include <string>
+#include <string_view>
 
 enum class TokenKind {
     EndOfFile,
@@ -17,42 +18,48 @@ enum class TokenKind {
     Comma,
 };
 
+/**
+ * \brief A token of a JSON document. Its text points into the scanned
+ * buffer; for a string literal, it's the raw content between the quotes,
+ * and `escaped` tells whether it still has escape sequences to decode.
+ */
 struct Token {
     TokenKind kind;
-    std::string text;
+    std::string_view text;
+    bool escaped = false;
 };
 
-// std::string tokenKindToString(TokenKind kind) {
-//     switch (kind) {
-//         case TokenKind::EndOfFile:
-//             return "EndOfFile";
-//         case TokenKind::StringLiteral:
-//             return "StringLiteral";
-//         case TokenKind::NumberLiteral:
-//             return "NumberLiteral";
-//         case TokenKind::BooleanLiteral:
-//             return "BooleanLiteral";
-//         case TokenKind::NullLiteral:
-//             return "NullLiteral";
-//         case TokenKind::OpenBracket:
-//             return "OpenBracket";
-//         case TokenKind::CloseBracket:
-//             return "CloseBracket";
-//         case TokenKind::OpenBrace:
-//             return "OpenBrace";
-//         case TokenKind::CloseBrace:
-//             return "CloseBrace";
-//         case TokenKind::Colon:
-//             return "Colon";
-//         case TokenKind::Comma:
-//             return "Comma";
-//     }
+inline std::string tokenKindToString(TokenKind kind) {
+    switch (kind) {
+        case TokenKind::EndOfFile:
+            return "EndOfFile";
+        case TokenKind::StringLiteral:
+            return "StringLiteral";
+        case TokenKind::NumberLiteral:
+            return "NumberLiteral";
+        case TokenKind::BooleanLiteral:
+            return "BooleanLiteral";
+        case TokenKind::NullLiteral:
+            return "NullLiteral";
+        case TokenKind::OpenBracket:
+            return "OpenBracket";
+        case TokenKind::CloseBracket:
+            return "CloseBracket";
+        case TokenKind::OpenBrace:
+            return "OpenBrace";
+        case TokenKind::CloseBrace:
+            return "CloseBrace";
+        case TokenKind::Colon:
+            return "Colon";
+        case TokenKind::Comma:
+            return "Comma";
+    }
 
-//     return "unknown";
-// }
+    return "unknown";
+}
 
-// std::string tokenToString(const Token& token) {
-//     return tokenKindToString(token.kind) + ": " + token.text;
-// }
+inline std::string tokenToString(const Token& token) {
+    return tokenKindToString(token.kind) + ": " + std::string(token.text);
+}
 
 #endif
@@ -1,2 +1,4 @@
 #include "JsonValue.hpp"
+#include "JsonReader.hpp"
 #include "parse-json.hpp"
+#include "JsonBinding.hpp"
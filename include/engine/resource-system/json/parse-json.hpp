@@ -1,88 +1,170 @@
 #ifndef PARSE_JSON_HPP
 #define PARSE_JSON_HPP
 
-#include <cassert>
-#include <unordered_map>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
 #include <vector>
+#include "JsonArena.hpp"
+#include "JsonReader.hpp"
 #include "JsonValue.hpp"
-#include "Scanner.hpp"
 
-namespace __detail {
-    JsonValue parseJSON(JsonScanner&);
-    JsonValue parseJSON(JsonScanner&, const Token&);
-    JsonValue parseArrayLiteral(JsonScanner&);
-    JsonValue parseObjectLiteral(JsonScanner&);
+/**
+ * \brief Handler that builds the values read by readJSON() in a new
+ * arena. The children of an array or object are gathered on a stack shared
+ * by the whole document, then moved into the arena once their number is
+ * known.
+ */
+class JsonValueBuilder : public JsonHandler {
+ public:
+    JsonValueBuilder();
 
-    inline void expect(TokenKind kind, const Token& token) {
-        assert(token.kind == kind);
-    }
+    void onStartObject();
+    void onKey(std::string_view);
+    void onEndObject();
+    void onStartArray();
+    void onEndArray();
+    void onString(std::string_view);
+    void onNumber(int64_t);
+    void onDouble(double);
+    void onBool(bool);
+    void onNull();
+
+    /**
+     * \brief Returns the value that was read, which owns the arena.
+     */
+    JsonValue result();
+
+ private:
+    struct Container {
+        bool array;
+        // Index of its first child in the stack
+        size_t first;
+        // Key of the member being read, in the arena
+        std::string_view key;
+    };
+
+    JsonValue root;
+    JsonArena* arena;
+    std::vector<Container> containers;
+    std::vector<JsonValue> elements;
+    std::vector<JsonMember> members;
+
+    void add(JsonValue&&);
+};
+
+inline JsonValueBuilder::JsonValueBuilder() {
+    // Owned by the root from the start, so it's freed if reading fails
+    root.arena = arena = new JsonArena();
 }
 
-inline JsonValue parseJSON(std::istream& inputStream) {
-    JsonScanner scanner;
-    scanner.setInputStream(inputStream);
-    return __detail::parseJSON(scanner);
+inline void JsonValueBuilder::onStartObject() {
+    containers.push_back({false, members.size(), {}});
 }
 
-namespace __detail {
-    inline JsonValue parseJSON(JsonScanner& scanner) {
-        return __detail::parseJSON(scanner, scanner.scan());
-    }
+inline void JsonValueBuilder::onKey(std::string_view key) {
+    containers.back().key = arena->copyString(key);
+}
+
+inline void JsonValueBuilder::onEndObject() {
+    size_t first = containers.back().first;
+    size_t count = members.size() - first;
+    JsonMember* result = arena->allocateArray<JsonMember>(count);
 
-    inline JsonValue parseJSON(JsonScanner& scanner, const Token& token) {
-        switch (token.kind) {
-            case TokenKind::StringLiteral:
-                return token.text;
-            case TokenKind::NumberLiteral:
-                return std::stoi(token.text);
-            case TokenKind::BooleanLiteral:
-                return token.text == "true";
-            case TokenKind::NullLiteral:
-                return nullptr;
-            case TokenKind::OpenBracket:
-                return __detail::parseArrayLiteral(scanner);
-            case TokenKind::OpenBrace:
-                return __detail::parseObjectLiteral(scanner);
-            default:
-                assert(false);
-        }
+    for (size_t i = 0; i < count; ++i) {
+        new (result + i) JsonMember(std::move(members[first + i]));
     }
 
-    inline JsonValue parseArrayLiteral(JsonScanner& scanner) {
-        std::vector<JsonValue> result;
-        Token token = scanner.scan();
+    members.resize(first);
+    containers.pop_back();
 
-        while (token.kind != TokenKind::CloseBracket) {
-            if (result.size() > 0) {
-                expect(TokenKind::Comma, token);
-                token = scanner.scan();
-            }
+    JsonValue value;
+    value.valueType = JsonValue::Type::Object;
+    value.length = static_cast<uint32_t>(count);
+    value.payload.members = result;
+    add(std::move(value));
+}
 
-            result.push_back(parseJSON(scanner, token));
-            token = scanner.scan();
-        }
+inline void JsonValueBuilder::onStartArray() {
+    containers.push_back({true, elements.size(), {}});
+}
 
-        return result;
+inline void JsonValueBuilder::onEndArray() {
+    size_t first = containers.back().first;
+    size_t count = elements.size() - first;
+    JsonValue* result = arena->allocateArray<JsonValue>(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        new (result + i) JsonValue(std::move(elements[first + i]));
     }
 
-    inline JsonValue parseObjectLiteral(JsonScanner& scanner) {
-        std::unordered_map<std::string, JsonValue> result;
-        Token token = scanner.scan();
+    elements.resize(first);
+    containers.pop_back();
+
+    JsonValue value;
+    value.valueType = JsonValue::Type::Array;
+    value.length = static_cast<uint32_t>(count);
+    value.payload.elements = result;
+    add(std::move(value));
+}
+
+inline void JsonValueBuilder::onString(std::string_view text) {
+    JsonValue value;
+    value.valueType = JsonValue::Type::String;
+    value.length = static_cast<uint32_t>(text.size());
+    value.payload.string = arena->copyString(text).data();
+    add(std::move(value));
+}
+
+inline void JsonValueBuilder::onNumber(int64_t number) {
+    add(number);
+}
+
+inline void JsonValueBuilder::onDouble(double number) {
+    add(number);
+}
 
-        while (token.kind != TokenKind::CloseBrace) {
-            if (result.size() > 0) {
-                expect(TokenKind::Comma, token);
-                token = scanner.scan();
-            }
+inline void JsonValueBuilder::onBool(bool boolean) {
+    add(boolean);
+}
 
-            expect(TokenKind::StringLiteral, token);
-            expect(TokenKind::Colon, scanner.scan());
-            result.insert({token.text, parseJSON(scanner)});
-            token = scanner.scan();
-        }
+inline void JsonValueBuilder::onNull() {
+    add(nullptr);
+}
 
-        return result;
+inline JsonValue JsonValueBuilder::result() {
+    return std::move(root);
+}
+
+inline void JsonValueBuilder::add(JsonValue&& value) {
+    if (containers.empty()) {
+        root.copyNode(value);
+    } else if (containers.back().array) {
+        elements.push_back(std::move(value));
+    } else {
+        members.push_back({containers.back().key, std::move(value)});
     }
 }
 
+/**
+ * \brief Parses a JSON document held in memory, such as a mapped file.
+ * The result doesn't point into the input.
+ */
+inline JsonValue parseJSON(std::string_view input) {
+    JsonValueBuilder builder;
+    readJSON(input, builder);
+    return builder.result();
+}
+
+/**
+ * \brief Reads the rest of a stream, then parses it as a JSON document.
+ */
+inline JsonValue parseJSON(std::istream& inputStream) {
+    std::string input(std::istreambuf_iterator<char>(inputStream), {});
+    return parseJSON(std::string_view(input));
+}
+
 #endif
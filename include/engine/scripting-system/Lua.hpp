@@ -1,7 +1,9 @@
 #ifndef SCRIPTING_SYSTEM_LUA_HPP
 #define SCRIPTING_SYSTEM_LUA_HPP
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 #include "LuaWrapper.hpp"
@@ -47,15 +49,30 @@ namespace engine::scriptingsystem {
         template<typename Functor>
         void registerNative(const std::string& luaFunctionName, Functor fn);
 
+        /**
+         * \brief Returns the identifier of the underlying %Lua state. It
+         * changes when another instance is moved into this one, e.g when a
+         * stored script is hot reloaded in place.
+         */
+        uint64_t stateId() const;
+
      private:
         LuaWrapper luaState;
+        uint64_t id;
 
         size_t pushVariableValue(const std::string& variableName);
         void pushGlobalOrField(const std::string& value, size_t level);
         std::vector<std::string> getVariableComponents(const std::string& variableName) const;
     };
 
-    inline Lua::Lua(const std::string& filename) : luaState(filename) { }
+    inline Lua::Lua(const std::string& filename) : luaState(filename) {
+        static std::atomic<uint64_t> nextId{1};
+        id = nextId++;
+    }
+
+    inline uint64_t Lua::stateId() const {
+        return id;
+    }
 
     template<typename T>
     inline void Lua::set(const std::string& variableName, const T& value) {
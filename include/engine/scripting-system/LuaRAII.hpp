@@ -2,6 +2,7 @@
 #define SCRIPTING_SYSTEM_LUA_RAII_HPP
 
 #include <stdexcept>
+#include <utility>
 
 extern "C" {
     #include <lua.h>
@@ -50,8 +51,8 @@ namespace engine::scriptingsystem {
     }
 
     inline LuaRAII& LuaRAII::operator=(LuaRAII&& other) {
-        L = other.L;
-        other.L = nullptr;
+        // The old state is closed when other is destroyed
+        std::swap(L, other.L);
         return *this;
     }
 }
@@ -0,0 +1,18 @@
+#ifndef SPRITE_SYSTEM_ATLAS_REGION_HPP
+#define SPRITE_SYSTEM_ATLAS_REGION_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+
+namespace engine::spritesystem {
+    /**
+     * \brief Where an image was packed in a texture atlas: the id of the
+     * page and the part of it that holds the image.
+     */
+    struct AtlasRegion {
+        std::string page;
+        sf::IntRect rect;
+    };
+}
+
+#endif
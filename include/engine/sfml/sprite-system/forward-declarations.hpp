@@ -3,9 +3,15 @@
 namespace engine::spritesystem {
     struct AnimationData;
     struct AnimationPlaybackData;
+    struct AtlasRegion;
     struct LoopingAnimationData;
+    struct TextureAtlas;
     template<typename TAnimationData>
     class AnimationPlayer;
     template<typename TAnimationData>
-    void playAnimations(entitysystem::ComponentManager&);
+    void playAnimations(
+        entitysystem::ComponentManager&,
+        entitysystem::CommandBuffer&,
+        double timeSinceLastFrame
+    );
 }
@@ -1,4 +1,6 @@
 #include "AnimationData.hpp"
 #include "AnimationPlaybackData.hpp"
+#include "AtlasRegion.hpp"
 #include "LoopingAnimationData.hpp"
+#include "pack-atlas.hpp"
 #include "play-animations.hpp"
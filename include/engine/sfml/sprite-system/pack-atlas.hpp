@@ -0,0 +1,125 @@
+#ifndef SPRITE_SYSTEM_PACK_ATLAS_HPP
+#define SPRITE_SYSTEM_PACK_ATLAS_HPP
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "AtlasRegion.hpp"
+
+namespace engine::spritesystem {
+    /**
+     * \brief Images packed into pages, before they're uploaded as textures.
+     */
+    struct TextureAtlas {
+        // Pages by id
+        std::vector<std::pair<std::string, sf::Image>> pages;
+        // Regions by the id of the image they hold
+        std::unordered_map<std::string, AtlasRegion> regions;
+    };
+
+    /**
+     * \brief Packs images into as few pages as fit in `maxPageSize`, placing
+     * them in rows sorted by height. Pages are named `name-0`, `name-1` and
+     * so on. Images are kept `padding` pixels apart so that scaled sprites
+     * don't sample their neighbours. Throws std::runtime_error if an image
+     * is larger than a page.
+     */
+    inline TextureAtlas packAtlas(
+        const std::string& name,
+        const std::vector<std::pair<std::string, sf::Image>>& images,
+        unsigned maxPageSize,
+        unsigned padding = 1
+    ) {
+        std::vector<size_t> order(images.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            sf::Vector2u sizeA = images[a].second.getSize();
+            sf::Vector2u sizeB = images[b].second.getSize();
+            return std::make_pair(sizeA.y, sizeA.x) > std::make_pair(sizeB.y, sizeB.x);
+        });
+
+        // Rows are about as wide as a square page holding every image
+        unsigned widestImage = 0;
+        double totalArea = 0;
+
+        for (const auto& [id, image] : images) {
+            sf::Vector2u size = image.getSize();
+
+            if (size.x > maxPageSize || size.y > maxPageSize) {
+                throw std::runtime_error("Image too large for an atlas page: " + id);
+            }
+
+            widestImage = std::max(widestImage, size.x);
+            totalArea += double(size.x + padding) * (size.y + padding);
+        }
+
+        unsigned rowWidth = std::max(widestImage, unsigned(std::ceil(std::sqrt(totalArea))));
+        rowWidth = std::min(rowWidth, maxPageSize);
+
+        struct Placement {
+            size_t image;
+            unsigned x;
+            unsigned y;
+        };
+
+        std::vector<std::vector<Placement>> pagePlacements(images.empty() ? 0 : 1);
+        std::vector<sf::Vector2u> pageSizes(pagePlacements.size());
+        unsigned x = 0;
+        unsigned rowY = 0;
+        unsigned rowHeight = 0;
+
+        for (size_t index : order) {
+            sf::Vector2u size = images[index].second.getSize();
+
+            if (x > 0 && x + size.x > rowWidth) {
+                x = 0;
+                rowY += rowHeight + padding;
+                rowHeight = 0;
+            }
+
+            if (rowY > 0 && rowY + size.y > maxPageSize) {
+                pagePlacements.emplace_back();
+                pageSizes.emplace_back();
+                x = 0;
+                rowY = 0;
+                rowHeight = 0;
+            }
+
+            pagePlacements.back().push_back({index, x, rowY});
+            sf::Vector2u& pageSize = pageSizes.back();
+            pageSize.x = std::max(pageSize.x, x + size.x);
+            pageSize.y = std::max(pageSize.y, rowY + size.y);
+            x += size.x + padding;
+            rowHeight = std::max(rowHeight, size.y);
+        }
+
+        TextureAtlas atlas;
+
+        for (size_t page = 0; page < pagePlacements.size(); ++page) {
+            std::string pageId = name + "-" + std::to_string(page);
+            sf::Image pageImage;
+            pageImage.create(pageSizes[page].x, pageSizes[page].y, sf::Color::Transparent);
+
+            for (const auto& [index, imageX, imageY] : pagePlacements[page]) {
+                const auto& [id, image] = images[index];
+                sf::Vector2u size = image.getSize();
+                pageImage.copy(image, imageX, imageY);
+                atlas.regions[id] = {pageId, sf::IntRect(
+                    int(imageX), int(imageY), int(size.x), int(size.y)
+                )};
+            }
+
+            atlas.pages.emplace_back(pageId, std::move(pageImage));
+        }
+
+        return atlas;
+    }
+}
+
+#endif
@@ -38,9 +38,15 @@ namespace engine::spritesystem {
         const TAnimationData* animationData;
     };
 
+    /**
+     * \brief Advances the animations of every entity with TAnimationData,
+     * removing the AnimationPlaybackData of the finished ones through
+     * `commands`, which is played back before returning.
+     */
     template<typename TAnimationData>
     inline void playAnimations(
         entitysystem::ComponentManager& manager,
+        entitysystem::CommandBuffer& commands,
         double timeSinceLastFrame
     ) {
         static AnimationPlayer<TAnimationData> animationPlayer;
@@ -56,7 +62,7 @@ namespace engine::spritesystem {
                 animationPlayer.tick(timeSinceLastFrame);
 
                 if (animationPlayer.isFinished()) {
-                    manager.removeComponent<AnimationPlaybackData>(entity);
+                    commands.removeComponent<AnimationPlaybackData>(entity);
                     return;
                 }
 
@@ -69,6 +75,8 @@ namespace engine::spritesystem {
                 });
             }
         );
+
+        commands.playback(manager);
     }
 
     template<>
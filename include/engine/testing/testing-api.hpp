@@ -2,6 +2,7 @@
 #define TESTING_API_HPP
 
 #include <functional>
+#include <string>
 
 namespace test {
     using Name = std::string;
@@ -0,0 +1,87 @@
+#ifndef UTILS_THREADING_THREAD_POOL_HPP
+#define UTILS_THREADING_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::utils {
+    /**
+     * \brief A fixed-size pool of threads that executes data-parallel loops.
+     *
+     * Each thread has its own queue of work. When a thread runs out of work,
+     * it steals from the back of the other queues, so uneven chunks don't
+     * leave cores idle. The thread calling parallelFor() also takes part in
+     * the work.
+     */
+    class ThreadPool {
+     public:
+        using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+        /**
+         * \brief Creates a pool that uses `numThreads` threads, including
+         * the calling thread. Defaults to the number of hardware threads.
+         */
+        explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /**
+         * \brief Returns the number of threads used by this pool, including
+         * the calling thread.
+         */
+        size_t size() const;
+
+        /**
+         * \brief Splits [0, count) into chunks of at most `grainSize` indexes
+         * and calls `fn(begin, end)` for each of them, in parallel. Blocks
+         * until all chunks are processed. If any call throws, the first
+         * exception is rethrown after the remaining chunks finish.
+         *
+         * The pool runs one loop at a time, so a parallelFor() called from
+         * inside `fn` can't be split among the threads, which are all busy
+         * with the outer loop. Such nested calls run their chunks in order
+         * on the calling thread instead.
+         */
+        void parallelFor(size_t count, size_t grainSize, const RangeFunction& fn);
+
+     private:
+        struct Range {
+            size_t begin;
+            size_t end;
+        };
+
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Range> ranges;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex jobMutex;
+        std::mutex stateMutex;
+        std::condition_variable jobAvailable;
+        std::condition_variable jobFinished;
+        const RangeFunction* job = nullptr;
+        size_t generation = 0;
+        std::atomic<size_t> remainingRanges{0};
+        std::exception_ptr error;
+        bool stopping = false;
+
+        void workerLoop(size_t queueIndex);
+        void runAvailableRanges(size_t queueIndex);
+        bool popRange(size_t queueIndex, Range&);
+    };
+}
+
+#endif
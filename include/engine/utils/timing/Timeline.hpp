@@ -0,0 +1,273 @@
+#ifndef UTILS_TIMING_TIMELINE_HPP
+#define UTILS_TIMING_TIMELINE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::utils {
+    namespace __detail {
+        // Returns the number of allocations made by the calling thread. Set
+        // by count-allocations.cpp in the programs it's linked into.
+        inline size_t (*allocationCounter)() = nullptr;
+    }
+
+    /**
+     * \brief A span of time measured by a ScopedTimer, along with what was
+     * done during it. Times are in microseconds since the timeline started.
+     * Allocations are only counted when the allocation counter is linked.
+     */
+    struct TimelineEvent {
+        std::string name;
+        size_t thread;
+        intmax_t start;
+        intmax_t duration;
+        size_t bytesRead;
+        std::optional<size_t> allocations;
+        size_t items;
+    };
+
+    /**
+     * \brief Collects the events measured from any thread, and writes them
+     * as a Chrome trace (chrome://tracing) or as a text summary.
+     */
+    class Timeline {
+     public:
+        using InternalClock = std::chrono::steady_clock;
+
+        /**
+         * \brief Returns the timeline that timers use by default. Its clock
+         * starts when it's first used.
+         */
+        static Timeline& global() {
+            static Timeline timeline;
+            return timeline;
+        }
+
+        /**
+         * \brief Returns the number of microseconds since the timeline
+         * started.
+         */
+        intmax_t now() const {
+            using namespace std::chrono;
+            return duration_cast<microseconds>(InternalClock::now() - startTime).count();
+        }
+
+        /**
+         * \brief Returns a small number that identifies the calling thread,
+         * assigned the first time each thread records an event.
+         */
+        size_t currentThread() {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto [it, inserted] = threads.insert({std::this_thread::get_id(), threads.size()});
+            return it->second;
+        }
+
+        void record(TimelineEvent event) {
+            std::lock_guard<std::mutex> lock(mutex);
+            recordedEvents.push_back(std::move(event));
+        }
+
+        /**
+         * \brief Returns the recorded events, sorted by start time. Enclosing
+         * events come before the ones they enclose.
+         */
+        std::vector<TimelineEvent> events() const {
+            std::vector<TimelineEvent> result;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                result = recordedEvents;
+            }
+
+            std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+                return a.start != b.start ? a.start < b.start : a.duration > b.duration;
+            });
+
+            return result;
+        }
+
+        void writeChromeTrace(std::ostream& stream) const {
+            stream << "{\"traceEvents\":[";
+            bool first = true;
+
+            for (const auto& event : events()) {
+                stream << (first ? "\n" : ",\n");
+                stream << "{\"name\":\"" << escape(event.name) << "\",\"cat\":\"startup\""
+                       << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                       << ",\"ts\":" << event.start << ",\"dur\":" << event.duration
+                       << ",\"args\":{\"bytes-read\":" << event.bytesRead
+                       << ",\"allocations\":"
+                       << (event.allocations ? std::to_string(*event.allocations) : "\"n/a\"")
+                       << ",\"items\":" << event.items << "}}";
+                first = false;
+            }
+
+            stream << "\n]}\n";
+        }
+
+        /**
+         * \brief Writes the events as a table, indenting each one under the
+         * events of the same thread that enclose it.
+         */
+        void writeSummary(std::ostream& stream) const {
+            std::vector<TimelineEvent> sortedEvents = events();
+            // End times of the open events of each thread, innermost last
+            std::unordered_map<size_t, std::vector<intmax_t>> openEvents;
+            char line[160];
+
+            std::snprintf(line, sizeof(line), "%10s %10s %12s %8s %7s %6s  %s\n",
+                "start(ms)", "time(ms)", "bytes read", "allocs", "items", "thread", "name");
+            stream << line;
+
+            for (const auto& event : sortedEvents) {
+                auto& stack = openEvents[event.thread];
+
+                while (!stack.empty() && stack.back() <= event.start) {
+                    stack.pop_back();
+                }
+
+                std::string name = std::string(2 * stack.size(), ' ') + event.name;
+                std::snprintf(line, sizeof(line), "%10.1f %10.1f %12zu %8s %7zu %6zu  %s\n",
+                    event.start / 1000.0, event.duration / 1000.0, event.bytesRead,
+                    countOrNA(event.allocations).c_str(), event.items, event.thread, name.c_str());
+                stream << line;
+                stack.push_back(event.start + event.duration);
+            }
+        }
+
+        /**
+         * \brief Writes a Chrome trace to a file. Returns false if it can't
+         * be written.
+         */
+        bool saveChromeTrace(const std::string& filename) const {
+            std::ofstream file(filename);
+            writeChromeTrace(file);
+            return static_cast<bool>(file);
+        }
+
+     private:
+        InternalClock::time_point startTime = InternalClock::now();
+        mutable std::mutex mutex;
+        std::vector<TimelineEvent> recordedEvents;
+        std::unordered_map<std::thread::id, size_t> threads;
+
+        static std::string countOrNA(const std::optional<size_t>& count) {
+            return count ? std::to_string(*count) : "n/a";
+        }
+
+        static std::string escape(const std::string& text) {
+            std::string result;
+
+            for (char ch : text) {
+                if (ch == '"' || ch == '\\') {
+                    result += '\\';
+                }
+
+                result += ch;
+            }
+
+            return result;
+        }
+    };
+
+    /**
+     * \brief Measures the time from its construction to its destruction and
+     * records it in a Timeline. The measured code reports the bytes it read
+     * and the items it produced; allocations made by the calling thread
+     * meanwhile are counted automatically if count-allocations.cpp is linked
+     * into the program. Timers nest: what an inner timer measures is also
+     * added to the timer that encloses it.
+     */
+    class ScopedTimer {
+     public:
+        explicit ScopedTimer(std::string name, Timeline& timeline = Timeline::global())
+         : timeline(timeline),
+           parent(current()),
+           event{std::move(name), timeline.currentThread(), timeline.now(), 0, 0, std::nullopt, 0},
+           startAllocations(countAllocations()) {
+            current() = this;
+        }
+
+        ~ScopedTimer() {
+            event.duration = timeline.now() - event.start;
+            std::optional<size_t> endAllocations = countAllocations();
+
+            if (startAllocations && endAllocations) {
+                event.allocations = *endAllocations - *startAllocations;
+            }
+
+            current() = parent;
+
+            if (parent) {
+                parent->event.bytesRead += event.bytesRead;
+            }
+
+            timeline.record(std::move(event));
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        void addItems(size_t count) {
+            event.items += count;
+        }
+
+        void addBytesRead(size_t count) {
+            event.bytesRead += count;
+        }
+
+        /**
+         * \brief Adds bytes read to the innermost timer of the calling
+         * thread, if any. Meant for helpers that don't know they're timed.
+         */
+        static void recordBytesRead(size_t count) {
+            if (current()) {
+                current()->addBytesRead(count);
+            }
+        }
+
+        /**
+         * \brief Adds the size of a file that was read to the innermost
+         * timer of the calling thread, if any.
+         */
+        static void recordFileRead(const std::string& filename) {
+            if (current()) {
+                std::ifstream file(filename, std::ios::binary | std::ios::ate);
+
+                if (file) {
+                    current()->addBytesRead(static_cast<size_t>(file.tellg()));
+                }
+            }
+        }
+
+     private:
+        Timeline& timeline;
+        ScopedTimer* parent;
+        TimelineEvent event;
+        std::optional<size_t> startAllocations;
+
+        static std::optional<size_t> countAllocations() {
+            if (__detail::allocationCounter) {
+                return __detail::allocationCounter();
+            }
+
+            return std::nullopt;
+        }
+
+        static ScopedTimer*& current() {
+            static thread_local ScopedTimer* timer = nullptr;
+            return timer;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef UTILS_TIMING_COUNT_ALLOCATIONS_HPP
+#define UTILS_TIMING_COUNT_ALLOCATIONS_HPP
+
+#include <cstddef>
+
+namespace engine::utils {
+    /**
+     * \brief Returns the number of allocations made by the calling thread
+     * so far. They're counted by the global allocation functions replaced
+     * in count-allocations.cpp, which is linked into every program that
+     * includes this header, so only benchmarks, tests and profiling builds
+     * should include it. ScopedTimers count allocations in those programs.
+     */
+    size_t allocationCount();
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef ASSET_TABLES_HPP
+#define ASSET_TABLES_HPP
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "battle/data/EncounterData.hpp"
+#include "battle/data/Move.hpp"
+#include "battle/data/PokemonSpeciesData.hpp"
+#include "engine/sfml/sprite-system/Frame.hpp"
+#include "TileData.hpp"
+
+class JsonValue;
+
+/**
+ * \brief Records of a data table, keyed by their id in the JSON files.
+ */
+template<typename T>
+using AssetTable = std::vector<std::pair<std::string, T>>;
+
+/**
+ * \brief An animation before its texture is resolved.
+ */
+struct AnimationRecord {
+    std::string texture;
+    std::vector<engine::spritesystem::Frame> frames;
+};
+
+/**
+ * \brief A map before its tiles are resolved.
+ */
+struct MapRecord {
+    size_t id;
+    std::string name;
+    size_t widthInTiles;
+    size_t heightInTiles;
+    std::vector<std::string> layer1;
+    // x, y and tile id of each tile of the second layer
+    std::vector<std::tuple<int, int, std::string>> layer2;
+};
+
+// Readers of the JSON data files, which are the source of truth for both
+// the runtime and the baked asset pack. The overloads that take a document
+// read the records of an already parsed file, or of part of one.
+AssetTable<TileData> readTilesJSON();
+AssetTable<TileData> readTilesJSON(const JsonValue&);
+AssetTable<AnimationRecord> readAnimationsJSON();
+AssetTable<AnimationRecord> readAnimationsJSON(const JsonValue&);
+AssetTable<PokemonSpeciesData> readSpeciesJSON();
+AssetTable<PokemonSpeciesData> readSpeciesJSON(const JsonValue&);
+AssetTable<Move> readMovesJSON();
+AssetTable<Move> readMovesJSON(const JsonValue&);
+AssetTable<MapEncounterData> readEncountersJSON();
+AssetTable<MapEncounterData> readEncountersJSON(const JsonValue&);
+AssetTable<MapRecord> readMapsJSON();
+AssetTable<MapRecord> readMapsJSON(const JsonValue&);
+
+#endif
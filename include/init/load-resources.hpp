@@ -1,8 +1,56 @@
 #ifndef LOAD_RESOURCES_HPP
 #define LOAD_RESOURCES_HPP
 
+#include <memory>
+#include <string>
 #include "engine/resource-system/forward-declarations.hpp"
+#include "engine/scripting-system/forward-declarations.hpp"
 
+struct Map;
+struct MapRecord;
+struct TileData;
+
+/**
+ * \brief Starts loading all game resources in the background. The
+ * returned loader must be updated until it finishes, on the thread that
+ * renders.
+ */
+std::unique_ptr<engine::resourcesystem::ResourceLoader> startLoadingResources(
+    engine::resourcesystem::ResourceStorage&
+);
+
+/**
+ * \brief Loads all game resources, blocking until they're ready.
+ */
 void loadResources(engine::resourcesystem::ResourceStorage&);
 
+/**
+ * \brief Points a tile read from tiles.json to the atlas page its texture
+ * was packed in, offsetting its rect accordingly.
+ */
+void moveToAtlas(TileData&, engine::resourcesystem::ResourceStorage&);
+
+/**
+ * \brief Builds a map from its record, resolving its tiles from the
+ * storage.
+ */
+Map buildMap(const MapRecord&, engine::resourcesystem::ResourceStorage&);
+
+/**
+ * \brief Returns the id of the script of a map.
+ */
+std::string mapScriptId(const MapRecord&);
+
+/**
+ * \brief Opens a script of the scripts folder, given its id. Throws
+ * std::runtime_error if it can't be run.
+ */
+std::unique_ptr<engine::scriptingsystem::Lua> openScript(const std::string& id);
+
+/**
+ * \brief Registers the native functions that a script expects, given its
+ * id.
+ */
+void injectScriptFunctions(const std::string& id, engine::scriptingsystem::Lua&);
+
 #endif
@@ -4,11 +4,26 @@
 #include <SFML/Graphics.hpp>
 #include "engine/entity-system/forward-declarations.hpp"
 #include "engine/resource-system/forward-declarations.hpp"
+#include "engine/resource-system/ResourceStorage.hpp"
+
+class PokemonSpriteCache;
+
+/**
+ * \brief Handles of the resources looked up on every frame, resolved once
+ * per ResourceStorage by resolveRenderHandles().
+ */
+struct RenderHandles {
+    engine::resourcesystem::ResourceHandle<engine::resourcesystem::LoadingProgress> loadingProgress;
+    engine::resourcesystem::ResourceHandle<PokemonSpriteCache> pokemonSprites;
+};
+
+RenderHandles resolveRenderHandles(engine::resourcesystem::ResourceStorage&);
 
 void render(
     sf::RenderWindow&,
     engine::entitysystem::ComponentManager&,
-    engine::resourcesystem::ResourceStorage&
+    engine::resourcesystem::ResourceStorage&,
+    const RenderHandles&
 );
 
 #endif
@@ -3,6 +3,7 @@
 
 #include "../components/Direction.hpp"
 #include "../components/Position.hpp"
+#include "../engine/entity-system/CommandBuffer.hpp"
 #include "../engine/entity-system/types.hpp"
 #include "../engine/state-system/include.hpp"
 
@@ -17,6 +18,7 @@ class OverworldState : public engine::statesystem::State {
     CoreStructures& gameData;
     Entity player;
     Entity map;
+    engine::entitysystem::CommandBuffer animationCommands;
     bool pressingDirectionKey = false;
     Position lastPlayerTile = {999999, 999999};
 
@@ -0,0 +1,656 @@
+#include "AssetPack.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <sys/stat.h>
+#include "engine/resource-system/ResourceStorage.hpp"
+#include "engine/utils/timing/Timeline.hpp"
+#include "ResourceFiles.hpp"
+
+using engine::resourcesystem::BinaryReader;
+using engine::resourcesystem::BinaryWriter;
+
+namespace {
+    constexpr std::string_view MAGIC = "PKMNPACK";
+    // Magic, version and number of sections
+    constexpr size_t HEADER_SIZE = 8 + 4 + 4;
+    // Id, number of records, source hash, source size, source modification
+    // time, offset and size
+    constexpr size_t SECTION_ENTRY_SIZE = 4 + 4 + 8 + 8 + 8 + 8 + 8;
+
+    const char* sourceFile(AssetSection section) {
+        switch (section) {
+            case AssetSection::Tiles:
+                return ResourceFiles::TILES;
+            case AssetSection::Animations:
+                return ResourceFiles::ANIMATIONS;
+            case AssetSection::Species:
+                return ResourceFiles::POKEMON;
+            case AssetSection::Moves:
+                return ResourceFiles::MOVES;
+            case AssetSection::Encounters:
+                return ResourceFiles::ENCOUNTERS;
+        }
+
+        throw std::invalid_argument("unknown asset section");
+    }
+
+    uint64_t hashFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return engine::resourcesystem::__detail::fnv1a(contents.str());
+    }
+
+    struct FileStamp {
+        uint64_t size = 0;
+        // Nanoseconds since the epoch
+        uint64_t modified = 0;
+    };
+
+    /**
+     * \brief Returns the size and modification time of a file, or zeros if
+     * it doesn't exist.
+     */
+    FileStamp stampFile(const std::string& filename) {
+        struct stat status;
+
+        if (::stat(filename.c_str(), &status) != 0) {
+            return {};
+        }
+
+        FileStamp stamp;
+        stamp.size = static_cast<uint64_t>(status.st_size);
+        stamp.modified = static_cast<uint64_t>(status.st_mtim.tv_sec) * 1000000000
+            + static_cast<uint64_t>(status.st_mtim.tv_nsec);
+        return stamp;
+    }
+
+    // Record serialization. Maps are written with sorted keys, so that the
+    // same data always produces the same bytes.
+    void write(BinaryWriter& writer, const std::string& value) {
+        writer.writeString(value);
+    }
+
+    void read(BinaryReader& reader, std::string& value) {
+        value = reader.readString();
+    }
+
+    void write(BinaryWriter& writer, int value) {
+        writer.writeInt(value);
+    }
+
+    void read(BinaryReader& reader, int& value) {
+        value = reader.readInt();
+    }
+
+    void write(BinaryWriter& writer, float value) {
+        writer.writeFloat(value);
+    }
+
+    void read(BinaryReader& reader, float& value) {
+        value = reader.readFloat();
+    }
+
+    // Declared ahead of the container templates, which need to see them
+    void write(BinaryWriter&, const JsonValue&);
+    void read(BinaryReader&, JsonValue&);
+    void write(BinaryWriter&, const engine::spritesystem::Frame&);
+    void read(BinaryReader&, engine::spritesystem::Frame&);
+    void write(BinaryWriter&, const EvolutionData&);
+    void read(BinaryReader&, EvolutionData&);
+    void write(BinaryWriter&, const EncounterData&);
+    void read(BinaryReader&, EncounterData&);
+
+    template<typename T, typename U>
+    void write(BinaryWriter& writer, const std::pair<T, U>& value) {
+        write(writer, value.first);
+        write(writer, value.second);
+    }
+
+    template<typename T, typename U>
+    void read(BinaryReader& reader, std::pair<T, U>& value) {
+        read(reader, value.first);
+        read(reader, value.second);
+    }
+
+    template<typename T, size_t N>
+    void write(BinaryWriter& writer, const std::array<T, N>& values) {
+        for (const auto& value : values) {
+            write(writer, value);
+        }
+    }
+
+    template<typename T, size_t N>
+    void read(BinaryReader& reader, std::array<T, N>& values) {
+        for (auto& value : values) {
+            read(reader, value);
+        }
+    }
+
+    template<typename T>
+    void write(BinaryWriter& writer, const std::vector<T>& values) {
+        writer.writeU32(static_cast<uint32_t>(values.size()));
+
+        for (const auto& value : values) {
+            write(writer, value);
+        }
+    }
+
+    template<typename T>
+    void read(BinaryReader& reader, std::vector<T>& values) {
+        uint32_t size = reader.readU32();
+
+        // Every element takes at least a byte, so a larger count comes from
+        // a corrupt pack and mustn't be allocated
+        if (size > reader.remaining()) {
+            throw std::out_of_range("AssetPack: more elements than bytes left");
+        }
+
+        values.resize(size);
+
+        for (auto& value : values) {
+            read(reader, value);
+        }
+    }
+
+    enum class JsonTag : uint8_t {
+        Empty,
+        Null,
+        Boolean,
+        Integer,
+        String,
+        Array,
+        Object,
+        Double
+    };
+
+    void write(BinaryWriter& writer, const JsonValue& value) {
+        if (value.is<std::nullptr_t>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Null));
+        } else if (value.is<bool>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Boolean));
+            writer.writeBool(value.asBool());
+        } else if (value.is<int64_t>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Integer));
+            writer.writeInt64(value.asInt64());
+        } else if (value.is<double>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Double));
+            writer.writeDouble(value.asDouble());
+        } else if (value.is<std::string>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::String));
+            writer.writeString(value.asStringView());
+        } else if (value.is<std::vector<JsonValue>>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Array));
+            auto array = value.asIterableArray();
+            writer.writeU32(static_cast<uint32_t>(array.size()));
+
+            for (const auto& member : array) {
+                write(writer, member);
+            }
+        } else if (value.is<std::unordered_map<std::string, JsonValue>>()) {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Object));
+            auto object = value.asIterableMap();
+            std::map<std::string_view, const JsonValue*> sorted;
+
+            for (const auto& [key, member] : object) {
+                sorted[key] = &member;
+            }
+
+            writer.writeU32(static_cast<uint32_t>(sorted.size()));
+
+            for (const auto& [key, member] : sorted) {
+                writer.writeString(key);
+                write(writer, *member);
+            }
+        } else {
+            writer.writeU8(static_cast<uint8_t>(JsonTag::Empty));
+        }
+    }
+
+    void read(BinaryReader& reader, JsonValue& value) {
+        switch (static_cast<JsonTag>(reader.readU8())) {
+            case JsonTag::Empty:
+                value = JsonValue();
+                break;
+            case JsonTag::Null:
+                value = nullptr;
+                break;
+            case JsonTag::Boolean:
+                value = reader.readBool();
+                break;
+            case JsonTag::Integer:
+                value = reader.readInt64();
+                break;
+            case JsonTag::Double:
+                value = reader.readDouble();
+                break;
+            case JsonTag::String:
+                value = std::string(reader.readString());
+                break;
+            case JsonTag::Array: {
+                std::vector<JsonValue> array;
+                read(reader, array);
+                value = array;
+                break;
+            }
+            case JsonTag::Object: {
+                std::unordered_map<std::string, JsonValue> object;
+                uint32_t size = reader.readU32();
+
+                for (uint32_t i = 0; i < size; ++i) {
+                    std::string key(reader.readString());
+                    read(reader, object[key]);
+                }
+
+                value = object;
+                break;
+            }
+            default:
+                throw std::runtime_error("AssetPack: invalid JSON value tag");
+        }
+    }
+
+    void write(BinaryWriter& writer, const TileData& tile) {
+        write(writer, tile.texture);
+        write(writer, tile.rect.left);
+        write(writer, tile.rect.top);
+        write(writer, tile.rect.width);
+        write(writer, tile.rect.height);
+    }
+
+    void read(BinaryReader& reader, TileData& tile) {
+        read(reader, tile.texture);
+        read(reader, tile.rect.left);
+        read(reader, tile.rect.top);
+        read(reader, tile.rect.width);
+        read(reader, tile.rect.height);
+    }
+
+    void write(BinaryWriter& writer, const engine::spritesystem::Frame& frame) {
+        write(writer, frame.x);
+        write(writer, frame.y);
+        write(writer, frame.width);
+        write(writer, frame.height);
+        write(writer, frame.lengthInMilliseconds);
+    }
+
+    void read(BinaryReader& reader, engine::spritesystem::Frame& frame) {
+        read(reader, frame.x);
+        read(reader, frame.y);
+        read(reader, frame.width);
+        read(reader, frame.height);
+        read(reader, frame.lengthInMilliseconds);
+    }
+
+    void write(BinaryWriter& writer, const AnimationRecord& animation) {
+        write(writer, animation.texture);
+        write(writer, animation.frames);
+    }
+
+    void read(BinaryReader& reader, AnimationRecord& animation) {
+        read(reader, animation.texture);
+        read(reader, animation.frames);
+    }
+
+    void write(BinaryWriter& writer, const EvolutionData& evolution) {
+        write(writer, evolution.pokemon);
+        write(writer, evolution.method);
+    }
+
+    void read(BinaryReader& reader, EvolutionData& evolution) {
+        read(reader, evolution.pokemon);
+        read(reader, evolution.method);
+    }
+
+    void write(BinaryWriter& writer, const PokemonSpeciesData& species) {
+        write(writer, species.displayName);
+        write(writer, species.nationalNumber);
+        write(writer, species.types);
+        write(writer, species.baseStats);
+        write(writer, species.maleRatio);
+        write(writer, species.growthRate);
+        write(writer, species.baseExp);
+        write(writer, species.effortPoints);
+        write(writer, species.captureRate);
+        write(writer, species.baseHappiness);
+        write(writer, species.abilities);
+        write(writer, species.hiddenAbilities);
+        write(writer, species.moves);
+        write(writer, species.eggMoves);
+        write(writer, species.eggGroups);
+        write(writer, species.eggSteps);
+        write(writer, species.height);
+        write(writer, species.weight);
+        write(writer, species.color);
+        write(writer, species.shape);
+        write(writer, species.habitat);
+        write(writer, species.kind);
+        write(writer, species.pokedexDescription);
+        write(writer, species.battlePlayerY);
+        write(writer, species.battleEnemyY);
+        write(writer, species.battleAltitude);
+        write(writer, species.evolutions);
+    }
+
+    void read(BinaryReader& reader, PokemonSpeciesData& species) {
+        read(reader, species.displayName);
+        read(reader, species.nationalNumber);
+        read(reader, species.types);
+        read(reader, species.baseStats);
+        read(reader, species.maleRatio);
+        read(reader, species.growthRate);
+        read(reader, species.baseExp);
+        read(reader, species.effortPoints);
+        read(reader, species.captureRate);
+        read(reader, species.baseHappiness);
+        read(reader, species.abilities);
+        read(reader, species.hiddenAbilities);
+        read(reader, species.moves);
+        read(reader, species.eggMoves);
+        read(reader, species.eggGroups);
+        read(reader, species.eggSteps);
+        read(reader, species.height);
+        read(reader, species.weight);
+        read(reader, species.color);
+        read(reader, species.shape);
+        read(reader, species.habitat);
+        read(reader, species.kind);
+        read(reader, species.pokedexDescription);
+        read(reader, species.battlePlayerY);
+        read(reader, species.battleEnemyY);
+        read(reader, species.battleAltitude);
+        read(reader, species.evolutions);
+    }
+
+    void write(BinaryWriter& writer, const Move& move) {
+        write(writer, move.id);
+        write(writer, move.displayName);
+        write(writer, move.type);
+        write(writer, move.kind);
+        write(writer, move.functionCode);
+        write(writer, move.functionParameter);
+        write(writer, move.power);
+        write(writer, move.accuracy);
+        write(writer, move.pp);
+        write(writer, move.effectRate);
+        write(writer, move.targetType);
+        write(writer, move.priority);
+        write(writer, move.flags);
+        write(writer, move.description);
+    }
+
+    void read(BinaryReader& reader, Move& move) {
+        read(reader, move.id);
+        read(reader, move.displayName);
+        read(reader, move.type);
+        read(reader, move.kind);
+        read(reader, move.functionCode);
+        read(reader, move.functionParameter);
+        read(reader, move.power);
+        read(reader, move.accuracy);
+        read(reader, move.pp);
+        read(reader, move.effectRate);
+        read(reader, move.targetType);
+        read(reader, move.priority);
+        read(reader, move.flags);
+        read(reader, move.description);
+    }
+
+    void write(BinaryWriter& writer, const EncounterData& encounter) {
+        write(writer, encounter.pokemon);
+        write(writer, encounter.minLevel);
+        write(writer, encounter.maxLevel);
+        write(writer, encounter.rate);
+    }
+
+    void read(BinaryReader& reader, EncounterData& encounter) {
+        read(reader, encounter.pokemon);
+        read(reader, encounter.minLevel);
+        read(reader, encounter.maxLevel);
+        read(reader, encounter.rate);
+    }
+
+    void write(BinaryWriter& writer, const MapEncounterData& mapEncounters) {
+        std::map<std::string_view, const std::vector<EncounterData>*> sorted;
+
+        for (const auto& [environment, encounters] : mapEncounters.encounterData) {
+            sorted[environment] = &encounters;
+        }
+
+        writer.writeU32(static_cast<uint32_t>(sorted.size()));
+
+        for (const auto& [environment, encounters] : sorted) {
+            writer.writeString(environment);
+            write(writer, *encounters);
+        }
+    }
+
+    void read(BinaryReader& reader, MapEncounterData& mapEncounters) {
+        uint32_t size = reader.readU32();
+
+        for (uint32_t i = 0; i < size; ++i) {
+            std::string environment(reader.readString());
+            read(reader, mapEncounters.encounterData[environment]);
+        }
+    }
+
+    /**
+     * \brief Serializes each record of a table on its own, keyed by id.
+     */
+    template<typename T>
+    std::map<std::string, std::string> serializeRecords(const AssetTable<T>& table) {
+        std::map<std::string, std::string> records;
+
+        for (const auto& [id, value] : table) {
+            BinaryWriter writer;
+            write(writer, value);
+            records[id] = writer.data();
+        }
+
+        return records;
+    }
+
+    template<typename T>
+    void writeSection(
+        BinaryWriter& writer,
+        AssetSection section,
+        const AssetTable<T>& table
+    ) {
+        size_t entryOffset = HEADER_SIZE + static_cast<size_t>(section) * SECTION_ENTRY_SIZE;
+        size_t sectionOffset = writer.size();
+
+        for (const auto& [id, bytes] : serializeRecords(table)) {
+            writer.writeString(id);
+            writer.writeString(bytes);
+        }
+
+        FileStamp stamp = stampFile(sourceFile(section));
+        writer.patchU32(entryOffset, static_cast<uint32_t>(section));
+        writer.patchU32(entryOffset + 4, static_cast<uint32_t>(table.size()));
+        writer.patchU64(entryOffset + 8, hashFile(sourceFile(section)));
+        writer.patchU64(entryOffset + 16, stamp.size);
+        writer.patchU64(entryOffset + 24, stamp.modified);
+        writer.patchU64(entryOffset + 32, sectionOffset);
+        writer.patchU64(entryOffset + 40, writer.size() - sectionOffset);
+    }
+
+    template<typename T>
+    void validateSection(
+        std::vector<std::string>& mismatches,
+        const std::string& sectionName,
+        const AssetTable<T>& jsonTable,
+        const AssetTable<T>& packTable
+    ) {
+        auto expected = serializeRecords(jsonTable);
+        auto actual = serializeRecords(packTable);
+
+        for (const auto& [id, bytes] : expected) {
+            auto it = actual.find(id);
+
+            if (it == actual.end()) {
+                mismatches.push_back(sectionName + ": missing record '" + id + "'");
+            } else if (it->second != bytes) {
+                mismatches.push_back(sectionName + ": record '" + id + "' differs");
+            }
+        }
+
+        for (const auto& [id, bytes] : actual) {
+            if (expected.count(id) == 0) {
+                mismatches.push_back(sectionName + ": unexpected record '" + id + "'");
+            }
+        }
+    }
+}
+
+AssetPack::AssetPack(const std::string& filename) : file(filename) {
+    BinaryReader reader(file.data(), file.size());
+
+    try {
+        if (reader.readBytes(MAGIC.size()) != MAGIC) {
+            throw std::runtime_error(filename + " is not an asset pack");
+        }
+
+        uint32_t version = reader.readU32();
+
+        if (version != VERSION) {
+            throw std::runtime_error(
+                filename + " has version " + std::to_string(version)
+                + ", expected " + std::to_string(VERSION)
+            );
+        }
+
+        if (reader.readU32() != NUM_SECTIONS) {
+            throw std::runtime_error(filename + " has an unexpected number of sections");
+        }
+
+        for (size_t i = 0; i < NUM_SECTIONS; ++i) {
+            uint32_t id = reader.readU32();
+
+            if (id >= NUM_SECTIONS) {
+                throw std::runtime_error(filename + " has an unknown section");
+            }
+
+            Section& section = sections[id];
+            section.numRecords = reader.readU32();
+            section.sourceHash = reader.readU64();
+            section.sourceSize = reader.readU64();
+            section.sourceModified = reader.readU64();
+            uint64_t offset = reader.readU64();
+            uint64_t size = reader.readU64();
+
+            if (offset > file.size() || size > file.size() - offset) {
+                throw std::runtime_error(filename + " has a section out of bounds");
+            }
+
+            section.records = BinaryReader(file.data() + offset, size);
+        }
+    } catch (const std::out_of_range&) {
+        throw std::runtime_error(filename + " is truncated");
+    }
+}
+
+void AssetPack::bake(const std::string& filename) {
+    BinaryWriter writer;
+    writer.writeBytes(MAGIC);
+    writer.writeU32(VERSION);
+    writer.writeU32(NUM_SECTIONS);
+
+    // Section entries are filled in as the sections are written
+    for (size_t i = 0; i < NUM_SECTIONS * SECTION_ENTRY_SIZE; ++i) {
+        writer.writeU8(0);
+    }
+
+    writeSection(writer, AssetSection::Tiles, readTilesJSON());
+    writeSection(writer, AssetSection::Animations, readAnimationsJSON());
+    writeSection(writer, AssetSection::Species, readSpeciesJSON());
+    writeSection(writer, AssetSection::Moves, readMovesJSON());
+    writeSection(writer, AssetSection::Encounters, readEncountersJSON());
+
+    // Written aside and then renamed, so that a pack is never seen half
+    // written
+    std::string temporaryFilename = filename + ".tmp";
+    std::ofstream output(temporaryFilename, std::ios::binary | std::ios::trunc);
+    output.write(writer.data().data(), writer.size());
+    output.close();
+
+    if (!output || std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+        std::remove(temporaryFilename.c_str());
+        throw std::runtime_error("Failed to write asset pack: " + filename);
+    }
+}
+
+bool AssetPack::isUpToDate(AssetSection id) const {
+    const Section& section = sections[static_cast<size_t>(id)];
+    FileStamp stamp = stampFile(sourceFile(id));
+    return section.sourceSize == stamp.size && section.sourceModified == stamp.modified;
+}
+
+AssetTable<TileData> AssetPack::tiles() const {
+    return readTable<TileData>(AssetSection::Tiles);
+}
+
+AssetTable<AnimationRecord> AssetPack::animations() const {
+    return readTable<AnimationRecord>(AssetSection::Animations);
+}
+
+AssetTable<PokemonSpeciesData> AssetPack::species() const {
+    return readTable<PokemonSpeciesData>(AssetSection::Species);
+}
+
+AssetTable<Move> AssetPack::moves() const {
+    return readTable<Move>(AssetSection::Moves);
+}
+
+AssetTable<MapEncounterData> AssetPack::encounters() const {
+    return readTable<MapEncounterData>(AssetSection::Encounters);
+}
+
+std::vector<std::string> AssetPack::validate() const {
+    std::vector<std::string> mismatches;
+
+    for (size_t i = 0; i < NUM_SECTIONS; ++i) {
+        const char* filename = sourceFile(static_cast<AssetSection>(i));
+
+        if (sections[i].sourceHash != hashFile(filename)) {
+            mismatches.push_back(std::string(filename) + " changed since the pack was baked");
+        }
+    }
+
+    validateSection(mismatches, "tiles", readTilesJSON(), tiles());
+    validateSection(mismatches, "animations", readAnimationsJSON(), animations());
+    validateSection(mismatches, "species", readSpeciesJSON(), species());
+    validateSection(mismatches, "moves", readMovesJSON(), moves());
+    validateSection(mismatches, "encounters", readEncountersJSON(), encounters());
+    return mismatches;
+}
+
+template<typename T>
+AssetTable<T> AssetPack::readTable(AssetSection id) const {
+    const Section& section = sections[static_cast<size_t>(id)];
+    BinaryReader reader = section.records;
+    AssetTable<T> table;
+
+    // Every record takes at least the lengths of its id and its bytes
+    if (section.numRecords > reader.remaining() / 8) {
+        throw std::out_of_range("AssetPack: more records than bytes left");
+    }
+
+    table.reserve(section.numRecords);
+    engine::utils::ScopedTimer::recordBytesRead(reader.remaining());
+
+    for (uint32_t i = 0; i < section.numRecords; ++i) {
+        std::string_view recordId = reader.readString();
+        std::string_view bytes = reader.readString();
+        BinaryReader record(bytes.data(), bytes.size());
+        T value;
+        read(record, value);
+        table.emplace_back(std::string(recordId), std::move(value));
+    }
+
+    return table;
+}
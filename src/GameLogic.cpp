@@ -1,6 +1,9 @@
 #include "GameLogic.hpp"
 
+#include <fstream>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
 #include "engine/entity-system/include.hpp"
 #include "engine/game-loop/SingleThreadGameLoop.hpp"
 #include "engine/resource-system/include.hpp"
@@ -8,8 +11,17 @@
 #include "init/load-resources.hpp"
 #include "init/register-states.hpp"
 #include "ResourceFiles.hpp"
+#include "ResourceIds.hpp"
 #include "Settings.hpp"
 
+// Links the allocation counter, so that the startup summary counts
+// allocations. Built with "make PROFILE_ALLOCATIONS=1".
+#ifdef PROFILE_ALLOCATIONS
+#include "engine/utils/timing/count-allocations.hpp"
+#endif
+
+#include "engine/utils/debug/xtrace.hpp"
+
 GameLogic::GameLogic(ComponentManager& manager, ResourceStorage& storage)
  : componentManager(manager),
    resourceStorage(storage),
@@ -24,14 +36,78 @@ GameLogic::GameLogic(ComponentManager& manager, ResourceStorage& storage)
     };
 
     Settings& settings = resourceStorage.get<Settings>("settings");
+    statsInterval = settings.getECSStatsInterval();
+    statsFile = settings.getECSStatsFile();
 
-    loadResources(resourceStorage);
-    registerStates(gameData);
-    stateMachine.pushState(settings.getInitialState());
+    using engine::resourcesystem::LoadingProgress;
+    resourceStorage.store(ResourceIds::LOADING_PROGRESS, LoadingProgress{});
+    LoadingProgress& progress = resourceStorage.get<LoadingProgress>(ResourceIds::LOADING_PROGRESS);
+
+    engine::utils::Timeline& timeline = engine::utils::Timeline::global();
+    loadingEvent = {"resources", timeline.currentThread(), timeline.now(), 0, 0, std::nullopt, 0};
+    resourceLoader = startLoadingResources(resourceStorage);
+    progress = resourceLoader->progress();
+    resourceLoader->setProgressCallback([&progress](const LoadingProgress& current) {
+        progress = current;
+    });
 }
 
 void GameLogic::operator()(SingleThreadGameLoop&, double timeSinceLastFrame) {
+    if (resourceLoader) {
+        if (resourceLoader->update()) {
+            finishLoading();
+        }
+
+        return;
+    }
+
+    // Reloaded resources are swapped here, before anything uses them in
+    // this frame
+    if (hotReloader) {
+        hotReloader->update();
+    }
+
     gameData.timeSinceLastFrame = &timeSinceLastFrame;
     inputDispatcher.tick();
     stateMachine.execute();
+
+    if (statsInterval > 0 && ++frameCount % statsInterval == 0) {
+        exportStats();
+    }
+}
+
+void GameLogic::finishLoading() {
+    resourceLoader.reset();
+    registerStates(gameData);
+    Settings& settings = resourceStorage.get<Settings>("settings");
+    stateMachine.pushState(settings.getInitialState());
+    reportStartup();
+
+    if (settings.getHotReload()) {
+        try {
+            hotReloader = std::make_unique<HotReloader>(resourceStorage, componentManager, HotReloader::Paths());
+        } catch (const std::runtime_error& error) {
+            ECHO("[HOT RELOAD] Disabled: " + std::string(error.what()));
+        }
+    }
+}
+
+void GameLogic::reportStartup() {
+    engine::utils::Timeline& timeline = engine::utils::Timeline::global();
+    loadingEvent.duration = timeline.now() - loadingEvent.start;
+    timeline.record(loadingEvent);
+
+    std::cout << "[STARTUP] Ready after " << timeline.now() / 1000.0 << " ms\n";
+    timeline.writeSummary(std::cout);
+
+    std::string traceFile = resourceStorage.get<Settings>("settings").getStartupTraceFile();
+
+    if (!traceFile.empty() && !timeline.saveChromeTrace(traceFile)) {
+        ECHO("[STARTUP] Failed to write " + traceFile);
+    }
+}
+
+void GameLogic::exportStats() {
+    std::ofstream file(statsFile, std::ios::app);
+    file << engine::entitysystem::toJSON(componentManager.stats()) << '\n';
 }
@@ -12,7 +12,8 @@
 
 GameRenderer::GameRenderer(ComponentManager& manager, ResourceStorage& storage)
  : componentManager(manager),
-   resourceStorage(storage) {
+   resourceStorage(storage),
+   renderHandles(resolveRenderHandles(storage)) {
     Camera& camera = storage.get<Camera>("camera");
     Settings& settings = storage.get<Settings>("settings");
 
@@ -74,7 +75,7 @@ void GameRenderer::operator()(SingleThreadGameLoop& game) {
     }
 
     window.clear();
-    render(window, componentManager, resourceStorage);
+    render(window, componentManager, resourceStorage, renderHandles);
     window.display();
 }
 
@@ -0,0 +1,348 @@
+#include "HotReloader.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include "components/Map.hpp"
+#include "engine/entity-system/include.hpp"
+#include "engine/resource-system/binary/MappedFile.hpp"
+#include "engine/resource-system/include.hpp"
+#include "engine/resource-system/json/include.hpp"
+#include "engine/scripting-system/include.hpp"
+#include "init/load-resources.hpp"
+
+#include "engine/utils/debug/xtrace.hpp"
+
+using engine::entitysystem::Entity;
+using engine::resourcesystem::ResourceLoader;
+using engine::scriptingsystem::Lua;
+
+namespace {
+    using JsonObject = std::unordered_map<std::string, JsonValue>;
+
+    JsonValue parseJSONFile(const std::string& filename) {
+        engine::resourcesystem::MappedFile file(filename);
+        return parseJSON(std::string_view(file.data(), file.size()));
+    }
+
+    bool startsWith(const std::string& text, const std::string& prefix) {
+        return text.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    bool endsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size()
+            && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Writes a value in a form that doesn't depend on the formatting of the
+    // file or on the order of object keys
+    void writeCanonical(const JsonValue& value, std::string& output) {
+        if (value.is<int64_t>()) {
+            output += 'i' + std::to_string(value.asInt64()) + ';';
+        } else if (value.is<double>()) {
+            // The shortest text that reads back as the same double
+            char text[32];
+            auto result = std::to_chars(std::begin(text), std::end(text), value.asDouble());
+            output += 'd';
+            output.append(text, result.ptr);
+            output += ';';
+        } else if (value.is<std::string>()) {
+            std::string_view text = value.asStringView();
+            output += 's' + std::to_string(text.size()) + ':';
+            output += text;
+        } else if (value.is<bool>()) {
+            output += value.asBool() ? "t" : "f";
+        } else if (value.is<std::vector<JsonValue>>()) {
+            output += '[';
+
+            for (const auto& member : value.asIterableArray()) {
+                writeCanonical(member, output);
+            }
+
+            output += ']';
+        } else if (value.is<JsonObject>()) {
+            std::map<std::string_view, const JsonValue*> sorted;
+
+            for (const auto& [key, member] : value.asIterableMap()) {
+                sorted[key] = &member;
+            }
+
+            output += '{';
+
+            for (const auto& [key, member] : sorted) {
+                output += 's' + std::to_string(key.size()) + ':';
+                output += key;
+                writeCanonical(*member, output);
+            }
+
+            output += '}';
+        } else {
+            output += 'n';
+        }
+    }
+
+    uint64_t digest(const JsonValue& value) {
+        std::string canonical;
+        writeCanonical(value, canonical);
+        return engine::resourcesystem::__detail::fnv1a(canonical);
+    }
+
+    // Adjusts a record read from JSON before it replaces the stored one
+    template<typename T>
+    void prepare(T&, engine::resourcesystem::ResourceStorage&) { }
+
+    void prepare(TileData& tile, engine::resourcesystem::ResourceStorage& storage) {
+        moveToAtlas(tile, storage);
+    }
+
+    std::unordered_map<std::string, uint64_t> recordDigests(const JsonValue& data) {
+        std::unordered_map<std::string, uint64_t> digests;
+
+        for (const auto& [id, record] : data.asIterableMap()) {
+            digests[std::string(id)] = digest(record);
+        }
+
+        return digests;
+    }
+
+    // Returns the records of a document whose digest isn't in `digests`,
+    // and fills `newDigests` with the digest of every record
+    JsonObject changedRecords(
+        const JsonValue& data,
+        const std::unordered_map<std::string, uint64_t>& digests,
+        std::unordered_map<std::string, uint64_t>& newDigests
+    ) {
+        JsonObject changed;
+
+        for (const auto& [id, record] : data.asIterableMap()) {
+            uint64_t recordDigest = digest(record);
+            auto it = digests.find(std::string(id));
+            newDigests[std::string(id)] = recordDigest;
+
+            if (it == digests.end() || it->second != recordDigest) {
+                changed.emplace(id, record);
+            }
+        }
+
+        return changed;
+    }
+}
+
+HotReloader::HotReloader(ResourceStorage& storage, ComponentManager& manager, Paths paths)
+ : storage(storage),
+   manager(manager),
+   paths(std::move(paths)) {
+    // Changed files are named after their folder, which the watcher ends
+    // with a slash
+    for (std::string* folder : {&this->paths.jsonFolder, &this->paths.scriptsFolder}) {
+        if (folder->empty() || folder->back() != '/') {
+            *folder += '/';
+        }
+
+        watcher.watch(*folder);
+    }
+
+    for (const auto& filename : {this->paths.encounters, this->paths.moves, this->paths.pokemon, this->paths.tiles}) {
+        digests[filename] = recordDigests(parseJSONFile(filename));
+    }
+
+    JsonValue mapData = parseJSONFile(this->paths.maps);
+    digests[this->paths.maps] = recordDigests(mapData);
+    maps = readMapsJSON(mapData);
+}
+
+HotReloader::~HotReloader() = default;
+
+void HotReloader::update() {
+    for (auto& filename : watcher.poll()) {
+        if (std::find(changedFiles.begin(), changedFiles.end(), filename) == changedFiles.end()) {
+            changedFiles.push_back(std::move(filename));
+        }
+    }
+
+    if (loader) {
+        try {
+            if (!loader->update()) {
+                return;
+            }
+        } catch (const std::exception& error) {
+            ECHO("[HOT RELOAD] Failed: " + std::string(error.what()));
+        }
+
+        loader.reset();
+    }
+
+    if (changedFiles.empty()) {
+        return;
+    }
+
+    // A single worker is enough for the few files saved at once
+    loader = std::make_unique<ResourceLoader>(1);
+
+    for (const auto& filename : changedFiles) {
+        reload(filename);
+    }
+
+    try {
+        loader->start();
+    } catch (const std::exception& error) {
+        ECHO("[HOT RELOAD] Failed: " + std::string(error.what()));
+        loader.reset();
+    }
+
+    changedFiles.clear();
+}
+
+void HotReloader::reload(const std::string& filename) {
+    if (startsWith(filename, paths.scriptsFolder) && endsWith(filename, ".lua")) {
+        std::string id = filename.substr(paths.scriptsFolder.size());
+        reloadScript(filename, id.substr(0, id.size() - 4));
+    } else if (filename == paths.encounters) {
+        reloadTable<MapEncounterData>(filename, "encounters-", readEncountersJSON);
+    } else if (filename == paths.maps) {
+        reloadMaps();
+    } else if (filename == paths.moves) {
+        reloadTable<Move>(filename, "move-", readMovesJSON);
+    } else if (filename == paths.pokemon) {
+        reloadTable<PokemonSpeciesData>(filename, "pokemon-", readSpeciesJSON);
+    } else if (filename == paths.tiles) {
+        // Map sprites copy the rects of their tiles, so the maps have to be
+        // rebuilt
+        reloadTable<TileData>(filename, "tile-", readTilesJSON, [this](const auto& tileIds) {
+            rebuildMaps(tileIds);
+        });
+    } else if (endsWith(filename, ".json")) {
+        ECHO("[HOT RELOAD] " + filename + " changed, restart to apply it");
+    }
+}
+
+template<typename T>
+void HotReloader::reloadTable(
+    const std::string& filename,
+    const std::string& prefix,
+    AssetTable<T> (*read)(const JsonValue&),
+    std::function<void(const std::vector<std::string>&)> applied
+) {
+    auto records = std::make_shared<AssetTable<T>>();
+    auto newDigests = std::make_shared<Digests>();
+    // Only written by this task's commit step, so it's safe to read while
+    // loading
+    const Digests& oldDigests = digests[filename];
+
+    loader->add(filename, {}, [filename, read, records, newDigests, &oldDigests] {
+        JsonValue data = parseJSONFile(filename);
+        *records = read(changedRecords(data, oldDigests, *newDigests));
+    }, [this, filename, prefix, applied, records, newDigests] {
+        std::vector<std::string> ids;
+
+        for (auto& [id, record] : *records) {
+            prepare(record, storage);
+            storage.replace(prefix + id, std::move(record));
+            ids.push_back(id);
+        }
+
+        digests[filename] = std::move(*newDigests);
+
+        if (applied && !ids.empty()) {
+            applied(ids);
+        }
+
+        ECHO("[HOT RELOAD] " + filename + ": " + std::to_string(ids.size()) + " record(s) updated");
+    });
+}
+
+void HotReloader::reloadScript(const std::string& filename, const std::string& id) {
+    auto script = std::make_shared<std::unique_ptr<Lua>>();
+
+    loader->add(filename, {}, [filename, script] {
+        *script = std::make_unique<Lua>(filename);
+    }, [this, filename, id, script] {
+        storage.replace(id, std::move(**script));
+        injectScriptFunctions(id, storage.get<Lua>(id));
+        ECHO("[HOT RELOAD] " + filename + ": OK");
+    });
+}
+
+void HotReloader::reloadMaps() {
+    using Scripts = std::vector<std::pair<std::string, std::unique_ptr<Lua>>>;
+    const std::string filename = paths.maps;
+    const std::string scriptsFolder = paths.scriptsFolder;
+    auto records = std::make_shared<AssetTable<MapRecord>>();
+    auto scripts = std::make_shared<Scripts>();
+    auto newDigests = std::make_shared<Digests>();
+    const Digests& oldDigests = digests[filename];
+    std::vector<std::string> dependencies;
+
+    // Changed tiles must be in place before the maps are rebuilt
+    if (std::count(changedFiles.begin(), changedFiles.end(), paths.tiles)) {
+        dependencies.push_back(paths.tiles);
+    }
+
+    loader->add(filename, dependencies, [filename, scriptsFolder, records, scripts, newDigests, &oldDigests] {
+        JsonValue data = parseJSONFile(filename);
+        *records = readMapsJSON(changedRecords(data, oldDigests, *newDigests));
+
+        // Scripts of existing maps are reloaded on their own
+        for (const auto& [id, record] : *records) {
+            if (!oldDigests.count(id)) {
+                std::string scriptId = mapScriptId(record);
+                scripts->emplace_back(scriptId, std::make_unique<Lua>(scriptsFolder + scriptId + ".lua"));
+            }
+        }
+    }, [this, filename, records, scripts, newDigests] {
+        for (auto& [id, script] : *scripts) {
+            storage.replace(id, std::move(*script));
+            injectScriptFunctions(id, storage.get<Lua>(id));
+        }
+
+        for (auto& [id, record] : *records) {
+            replaceMap(id, record);
+            auto it = std::find_if(maps.begin(), maps.end(), [&](const auto& entry) {
+                return entry.first == id;
+            });
+
+            if (it != maps.end()) {
+                it->second = std::move(record);
+            } else {
+                maps.emplace_back(id, std::move(record));
+            }
+        }
+
+        digests[filename] = std::move(*newDigests);
+        ECHO("[HOT RELOAD] " + filename + ": " + std::to_string(records->size()) + " map(s) updated");
+    });
+}
+
+void HotReloader::rebuildMaps(const std::vector<std::string>& tileIds) {
+    std::unordered_set<std::string> changedTiles(tileIds.begin(), tileIds.end());
+
+    for (const auto& [id, record] : maps) {
+        bool usesChangedTile = std::any_of(record.layer1.begin(), record.layer1.end(), [&](const auto& tileId) {
+            return changedTiles.count(tileId) > 0;
+        }) || std::any_of(record.layer2.begin(), record.layer2.end(), [&](const auto& tile) {
+            return changedTiles.count(std::get<2>(tile)) > 0;
+        });
+
+        if (usesChangedTile) {
+            replaceMap(id, record);
+        }
+    }
+}
+
+void HotReloader::replaceMap(const std::string& id, const MapRecord& record) {
+    Map map = buildMap(record, storage);
+
+    // Entities hold their own copy of the map they show
+    manager.query<Map>().forEach([&](Entity, Map& current) {
+        if (current.id == map.id) {
+            current = map;
+        }
+    });
+
+    storage.replace(id, std::move(map));
+}
@@ -1,9 +1,16 @@
 #include "Settings.hpp"
 
+#include <cstdint>
 #include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "engine/utils/timing/Timeline.hpp"
 #include "ResourceFiles.hpp"
 
 Settings::Settings() {
+    engine::utils::ScopedTimer timer("settings");
+    engine::utils::ScopedTimer::recordFileRead(ResourceFiles::SETTINGS);
     std::ifstream settingsFile(ResourceFiles::SETTINGS);
     data = parseJSON(settingsFile);
 }
@@ -33,7 +40,7 @@ int Settings::getMinWindowHeight() const {
 }
 
 float Settings::getPlayerWalkingSpeed() const {
-    return std::stof(data["player-walking-speed"].asString());
+    return static_cast<float>(data["player-walking-speed"].asDouble());
 }
 
 int Settings::getTileSize() const {
@@ -47,3 +54,47 @@ std::string Settings::getPokemonBackSpritesFolder() const {
 std::string Settings::getPokemonFrontSpritesFolder() const {
     return data["pokemon-front-sprites"].asString();
 }
+
+size_t Settings::getPokemonSpriteCacheBudget() const {
+    int64_t budget = data["pokemon-sprite-cache-budget"].asInt64();
+
+    if (budget <= 0 || uint64_t(budget) > std::numeric_limits<size_t>::max()) {
+        throw std::runtime_error("Invalid pokemon-sprite-cache-budget: " + std::to_string(budget));
+    }
+
+    return static_cast<size_t>(budget);
+}
+
+unsigned Settings::getPokemonSpriteSize() const {
+    int64_t size = data["pokemon-sprite-size"].asInt64();
+
+    if (size <= 0 || size > std::numeric_limits<int>::max()) {
+        throw std::runtime_error("Invalid pokemon-sprite-size: " + std::to_string(size));
+    }
+
+    return static_cast<unsigned>(size);
+}
+
+unsigned Settings::getMaxAtlasSize() const {
+    return static_cast<unsigned>(data["max-atlas-size"].asInt());
+}
+
+std::string Settings::getAssetPackFile() const {
+    return data["asset-pack"].asString();
+}
+
+bool Settings::getHotReload() const {
+    return data["hot-reload"].asBool();
+}
+
+int Settings::getECSStatsInterval() const {
+    return data["ecs-stats-interval"].asInt();
+}
+
+std::string Settings::getECSStatsFile() const {
+    return data["ecs-stats-file"].asString();
+}
+
+std::string Settings::getStartupTraceFile() const {
+    return data["startup-trace-file"].asString();
+}
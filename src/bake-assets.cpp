@@ -0,0 +1,51 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "AssetPack.hpp"
+#include "Settings.hpp"
+
+// Bakes the JSON data tables into the asset pack, or with --validate,
+// checks that an existing pack matches them
+int main(int argc, char** argv) {
+    bool validate = false;
+    std::string filename;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+
+        if (argument == "--validate") {
+            validate = true;
+        } else if (filename.empty() && argument[0] != '-') {
+            filename = argument;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--validate] [pack file]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (filename.empty()) {
+        filename = Settings().getAssetPackFile();
+    }
+
+    try {
+        if (!validate) {
+            AssetPack::bake(filename);
+            std::cout << "[BAKE] " << filename << ": OK" << std::endl;
+            return 0;
+        }
+
+        std::vector<std::string> mismatches = AssetPack(filename).validate();
+
+        for (const std::string& mismatch : mismatches) {
+            std::cout << "[VALIDATE] " << mismatch << std::endl;
+        }
+
+        std::cout << "[VALIDATE] " << filename << ": "
+                  << (mismatches.empty() ? "OK" : std::to_string(mismatches.size()) + " mismatches")
+                  << std::endl;
+        return mismatches.empty() ? 0 : 1;
+    } catch (const std::exception& error) {
+        std::cerr << "[BAKE] " << error.what() << std::endl;
+        return 1;
+    }
+}
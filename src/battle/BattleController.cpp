@@ -20,19 +20,20 @@
 #include "events/TextEvent.hpp"
 #include "EventQueue.hpp"
 #include "lua-native-functions.hpp"
+#include "ResourceIds.hpp"
 
 using engine::entitysystem::Entity;
 
 namespace {
     template<typename TEvent, typename... Args>
     void enqueueTurnEvent(CoreStructures& gameData, Args&&... args) {
-        EventQueue& queue = resource<EventQueue>("battle-event-queue", gameData);
+        EventQueue& queue = resource<EventQueue>(ResourceIds::BATTLE_EVENT_QUEUE, gameData);
         queue.addEvent(std::make_unique<TEvent>(std::forward<Args>(args)...));
     }
 
     template<typename TEvent, typename... Args>
     void enqueueMoveEvent(CoreStructures& gameData, Args&&... args) {
-        EventQueue& queue = resource<EventQueue>("move-event-queue", gameData);
+        EventQueue& queue = resource<EventQueue>(ResourceIds::MOVE_EVENT_QUEUE, gameData);
         queue.addEvent(std::make_unique<TEvent>(std::forward<Args>(args)...));
     }
 
@@ -65,8 +66,10 @@ BattleController::BattleController(
 
 void BattleController::startBattle() {
     assert(state == State::PENDING_START);
-    gameData->resourceStorage->store("battle-event-queue", EventQueue());
-    gameData->resourceStorage->store("move-event-queue", EventQueue());
+    gameData->resourceStorage->store(ResourceIds::BATTLE_EVENT_QUEUE, EventQueue());
+    gameData->resourceStorage->store(ResourceIds::MOVE_EVENT_QUEUE, EventQueue());
+    battleEventQueue = gameData->resourceStorage->handle<EventQueue>(ResourceIds::BATTLE_EVENT_QUEUE);
+    moveEventQueue = gameData->resourceStorage->handle<EventQueue>(ResourceIds::MOVE_EVENT_QUEUE);
     battle = &data<Battle>(battleEntity, *gameData);
     scriptVariables.setBattle(*battle);
     eventManager.setBattle(*battle);
@@ -83,26 +86,26 @@ void BattleController::startBattle() {
 }
 
 void BattleController::abort() {
-    gameData->resourceStorage->remove<EventQueue>("battle-event-queue");
-    gameData->resourceStorage->remove<EventQueue>("move-event-queue");
+    gameData->resourceStorage->remove<EventQueue>(ResourceIds::BATTLE_EVENT_QUEUE);
+    gameData->resourceStorage->remove<EventQueue>(ResourceIds::MOVE_EVENT_QUEUE);
     state = State::PENDING_START;
 }
 
 void BattleController::tick() {
     assert(state == State::READY);
-    auto& moveQueue = resource<EventQueue>("move-event-queue", *gameData);
+    auto& moveQueue = resource(moveEventQueue, *gameData);
 
     if (!moveQueue.empty()) {
         moveQueue.tick();
         return;
     }
 
-    resource<EventQueue>("battle-event-queue", *gameData).tick();
+    resource(battleEventQueue, *gameData).tick();
 }
 
 bool BattleController::hasPendingEvents() const {
-    return !resource<EventQueue>("move-event-queue", *gameData).empty()
-        || !resource<EventQueue>("battle-event-queue", *gameData).empty();
+    return !resource(moveEventQueue, *gameData).empty()
+        || !resource(battleEventQueue, *gameData).empty();
 }
 
 BattleController::State BattleController::getState() const {
@@ -274,8 +277,8 @@ void BattleController::checkFaintedPokemon() {
             bool opponentLost = isOpponentUnableToContinue();
 
             if (playerLost || opponentLost) {
-                resource<EventQueue>("move-event-queue", *gameData) = {};
-                resource<EventQueue>("battle-event-queue", *gameData) = {};
+                resource(moveEventQueue, *gameData) = {};
+                resource(battleEventQueue, *gameData) = {};
 
                 state = playerLost
                     ? (opponentLost ? State::DRAW : State::DEFEAT)
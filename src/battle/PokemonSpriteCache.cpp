@@ -0,0 +1,165 @@
+#include "battle/PokemonSpriteCache.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    std::string cacheKey(const std::string& species, SpriteSide side) {
+        return (side == SpriteSide::Back ? "back-" : "front-") + species;
+    }
+
+    sf::Image loadImage(const std::string& path) {
+        sf::Image image;
+
+        if (!image.loadFromFile(path)) {
+            throw std::runtime_error("Failed to load sprite: " + path);
+        }
+
+        return image;
+    }
+}
+
+PokemonSpriteCache::PokemonSpriteCache(
+    const std::string& backSpritesFolder,
+    const std::string& frontSpritesFolder,
+    size_t budget,
+    unsigned spriteSize
+) : backSpritesFolder(backSpritesFolder),
+    frontSpritesFolder(frontSpritesFolder),
+    spriteSize(spriteSize) {
+    if (spriteSize == 0 || budget == 0) {
+        throw std::invalid_argument("PokemonSpriteCache: the sprite size and the budget must be positive");
+    }
+
+    // A battle draws two sprites per frame, which must not evict each other
+    numSlots = std::max<size_t>(2, budget / slotBytes());
+    columns = static_cast<unsigned>(std::ceil(std::sqrt(double(numSlots))));
+
+    // Atlas coordinates are ints
+    if (uint64_t(columns) * spriteSize > uint64_t(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("PokemonSpriteCache: the budget is too large for one atlas");
+    }
+
+    // Slots are handed out from the back, lowest first
+    for (size_t slot = numSlots; slot > 0; --slot) {
+        freeSlots.push_back(slot - 1);
+    }
+}
+
+sf::Sprite PokemonSpriteCache::get(const std::string& species, SpriteSide side) {
+    std::string key = cacheKey(species, side);
+    auto it = entryIndex.find(key);
+
+    if (it != entryIndex.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        it->second->frame = frame;
+        return sf::Sprite(atlas, it->second->rect);
+    }
+
+    auto pending = pendingImages.find(key);
+
+    // A sprite that wasn't prefetched is decoded right away, which costs
+    // one slower frame instead of blank ones
+    if (pending == pendingImages.end()) {
+        auto image = std::async(std::launch::deferred, loadImage, path(species, side));
+        pending = pendingImages.emplace(key, std::move(image)).first;
+    }
+
+    auto status = pending->second.wait_for(std::chrono::seconds(0));
+
+    // Every slot may hold a sprite drawn in this frame, in which case the
+    // image is kept until one of them can be evicted
+    if (status == std::future_status::timeout || !canAllocateSlot()) {
+        return sf::Sprite();
+    }
+
+    std::future<sf::Image> future = std::move(pending->second);
+    pendingImages.erase(pending);
+    sf::Image image = future.get();
+    sf::Vector2u size = image.getSize();
+
+    if (size.x > spriteSize || size.y > spriteSize) {
+        throw std::runtime_error("Sprite larger than the cache slots: " + key);
+    }
+
+    if (!atlasCreated) {
+        unsigned rows = static_cast<unsigned>((numSlots + columns - 1) / columns);
+
+        if (!atlas.create(columns * spriteSize, rows * spriteSize)) {
+            throw std::runtime_error("Failed to create the sprite cache atlas");
+        }
+
+        atlasCreated = true;
+    }
+
+    size_t slot = allocateSlot();
+    unsigned x = static_cast<unsigned>(slot % columns) * spriteSize;
+    unsigned y = static_cast<unsigned>(slot / columns) * spriteSize;
+    atlas.update(image, x, y);
+
+    sf::IntRect rect(int(x), int(y), int(size.x), int(size.y));
+    entries.push_front({key, slot, rect, frame});
+    entryIndex[key] = entries.begin();
+    return sf::Sprite(atlas, rect);
+}
+
+void PokemonSpriteCache::prefetch(const std::string& species, SpriteSide side) {
+    std::string key = cacheKey(species, side);
+
+    if (entryIndex.count(key) || pendingImages.count(key)) {
+        return;
+    }
+
+    pendingImages[key] = std::async(std::launch::async, loadImage, path(species, side));
+}
+
+void PokemonSpriteCache::nextFrame() {
+    ++frame;
+}
+
+size_t PokemonSpriteCache::memoryUsage() const {
+    return entries.size() * slotBytes();
+}
+
+size_t PokemonSpriteCache::size() const {
+    return entries.size();
+}
+
+size_t PokemonSpriteCache::capacity() const {
+    return numSlots;
+}
+
+std::string PokemonSpriteCache::path(const std::string& species, SpriteSide side) const {
+    std::string lowercaseId = species;
+    std::transform(species.begin(), species.end(), lowercaseId.begin(), tolower);
+    const std::string& folder = (side == SpriteSide::Back) ? backSpritesFolder : frontSpritesFolder;
+    return folder + lowercaseId + ".png";
+}
+
+size_t PokemonSpriteCache::slotBytes() const {
+    return size_t(spriteSize) * spriteSize * 4;
+}
+
+bool PokemonSpriteCache::canAllocateSlot() const {
+    return !freeSlots.empty() || entries.back().frame != frame;
+}
+
+size_t PokemonSpriteCache::allocateSlot() {
+    // The atlas is full: reuse the slot of the least recently used sprite,
+    // which canAllocateSlot() checked wasn't requested in this frame
+    if (freeSlots.empty()) {
+        Entry& entry = entries.back();
+        freeSlots.push_back(entry.slot);
+        entryIndex.erase(entry.key);
+        entries.pop_back();
+    }
+
+    size_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    return slot;
+}
@@ -4,6 +4,7 @@
 #include "battle/data/Pokemon.hpp"
 #include "battle/helpers/battle-utils.hpp"
 #include "components/battle/Battle.hpp"
+#include "components/battle/VolatileData.hpp"
 #include "constants.hpp"
 #include "core-functions.hpp"
 #include "CoreStructures.hpp"
@@ -23,6 +24,7 @@ ScriptVariables::ScriptVariables(CoreStructures& gameData) : gameData(&gameData)
 
 void ScriptVariables::setBattle(Battle& _battle) {
     battle = &_battle;
+    syncedScripts.clear();
 }
 
 void ScriptVariables::updateScriptVariables() {
@@ -55,23 +57,42 @@ std::string ScriptVariables::findPokemonVariable(Entity entity) {
 }
 
 void ScriptVariables::updateScriptVariables(Lua& script) {
+    SyncedScript& synced = syncedScripts[&script];
+
+    if (synced.stateId != script.stateId()) {
+        synced = {script.stateId(), 0};
+    }
+
+    Tick sinceTick = synced.tick;
+    synced.tick = gameData->componentManager->advanceTick();
+
     for (size_t i = 0; i < battle->playerTeam.size(); ++i) {
-        std::string varName = "playerTeam[" + std::to_string(i) + "]";
-        updatePokemonVariables(battle->playerTeam[i], varName, script);
+        if (hasPokemonChangedSince(battle->playerTeam[i], sinceTick)) {
+            std::string varName = "playerTeam[" + std::to_string(i) + "]";
+            updatePokemonVariables(battle->playerTeam[i], varName, script);
+        }
     }
 
     for (size_t i = 0; i < battle->opponentTeam.size(); ++i) {
-        std::string varName = "opponentTeam[" + std::to_string(i) + "]";
-        updatePokemonVariables(battle->opponentTeam[i], varName, script);
+        if (hasPokemonChangedSince(battle->opponentTeam[i], sinceTick)) {
+            std::string varName = "opponentTeam[" + std::to_string(i) + "]";
+            updatePokemonVariables(battle->opponentTeam[i], varName, script);
+        }
     }
 }
 
+bool ScriptVariables::hasPokemonChangedSince(Entity pokemonEntity, Tick tick) const {
+    auto& manager = *gameData->componentManager;
+    return manager.hasChangedSince<Pokemon>(pokemonEntity, tick)
+        || manager.hasChangedSince<VolatileData>(pokemonEntity, tick);
+}
+
 void ScriptVariables::updatePokemonVariables(
     Entity pokemonEntity,
     const std::string& varName,
     Lua& script
 ) {
-    const Pokemon& currentPokemon = data<Pokemon>(pokemonEntity, *gameData);
+    const Pokemon& currentPokemon = readData<Pokemon>(pokemonEntity, *gameData);
 
     const auto getStat = [&](Stat stat) {
         return getEffectiveStat(pokemonEntity, stat, *gameData);
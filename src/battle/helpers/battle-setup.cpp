@@ -1,12 +1,17 @@
 #include "battle/helpers/battle-setup.hpp"
 
+#include <utility>
+#include <vector>
 #include "battle/data/EncounterData.hpp"
 #include "battle/data/Pokemon.hpp"
 #include "battle/helpers/generate-pokemon.hpp"
 #include "battle/helpers/random.hpp"
+#include "battle/PokemonSpriteCache.hpp"
 #include "components/battle/Battle.hpp"
 #include "core-functions.hpp"
 #include "CoreStructures.hpp"
+#include "engine/entity-system/include.hpp"
+#include "ResourceIds.hpp"
 
 Pokemon findWildBattleOpponent(
     const std::string& mapId,
@@ -29,6 +34,9 @@ Pokemon findWildBattleOpponent(
 
     const EncounterData& chosenEncounter = possibleEncounters.at(chosenEncounterIndex);
     std::string chosenSpecies = chosenEncounter.pokemon;
+    // Decodes the sprite while the rest of the battle is set up
+    resource<PokemonSpriteCache>(ResourceIds::POKEMON_SPRITES, gameData)
+        .prefetch(chosenSpecies, SpriteSide::Front);
     int chosenLevel = random(chosenEncounter.minLevel, chosenEncounter.maxLevel);
 
     return generatePokemon(*gameData.resourceStorage, chosenSpecies, chosenLevel);
@@ -40,12 +48,29 @@ void setupWildEncounter(
     CoreStructures& gameData
 ) {
     Pokemon player = generatePokemon(*gameData.resourceStorage, "Rattata", 3);
+    resource<PokemonSpriteCache>(ResourceIds::POKEMON_SPRITES, gameData)
+        .prefetch(player.species, SpriteSide::Back);
     auto playerEntity = createEntity(gameData);
-    addComponent(playerEntity, player, gameData);
+    addComponent(playerEntity, std::move(player), gameData);
 
     Pokemon opponent = findWildBattleOpponent(mapId, battle, gameData);
     auto opponentEntity = createEntity(gameData);
-    addComponent(opponentEntity, opponent, gameData);
+    addComponent(opponentEntity, std::move(opponent), gameData);
 
     addComponent(battle, Battle{{playerEntity}, {opponentEntity}}, gameData);
 }
+
+size_t teardownBattle(engine::entitysystem::Entity battle, CoreStructures& gameData) {
+    if (hasComponent<Battle>(battle, gameData)) {
+        Battle& battleData = data<Battle>(battle, gameData);
+
+        for (auto team : {&battleData.playerTeam, &battleData.opponentTeam}) {
+            for (auto pokemon : *team) {
+                deleteEntity(pokemon, gameData);
+            }
+        }
+    }
+
+    deleteEntity(battle, gameData);
+    return gameData.componentManager->cleanup();
+}
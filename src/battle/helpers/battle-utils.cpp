@@ -65,8 +65,8 @@ int getEffectiveStat(
     StatFlags flags
 ) {
     int statId = static_cast<int>(stat);
-    int baseStatValue = data<Pokemon>(pokemon, gameData).stats[statId];
-    int currentStage = data<VolatileData>(pokemon, gameData).statStages[statId];
+    int baseStatValue = readData<Pokemon>(pokemon, gameData).stats[statId];
+    int currentStage = readData<VolatileData>(pokemon, gameData).statStages[statId];
 
     switch (flags) {
         case StatFlags::All:
@@ -19,6 +19,7 @@
 #include "events/TextEvent.hpp"
 #include "EventQueue.hpp"
 #include "lua-native-functions.hpp"
+#include "ResourceIds.hpp"
 
 using engine::entitysystem::Entity;
 
@@ -38,7 +39,7 @@ namespace {
 
     template<typename TEvent, typename... Args>
     void enqueueEvent(Args&&... args) {
-        EventQueue& queue = resource<EventQueue>("move-event-queue", *gameData);
+        EventQueue& queue = resource<EventQueue>(ResourceIds::MOVE_EVENT_QUEUE, *gameData);
         queue.addEvent(std::make_unique<TEvent>(std::forward<Args>(args)...));
     }
 }
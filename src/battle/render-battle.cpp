@@ -1,12 +1,15 @@
 #include "render-textboxes.hpp"
 
 #include "battle/data/Pokemon.hpp"
+#include "battle/PokemonSpriteCache.hpp"
 #include "components/battle/Battle.hpp"
 #include "components/battle/BattleActionSelection.hpp"
 #include "components/battle/Fainted.hpp"
 #include "components/Camera.hpp"
 #include "engine/entity-system/include.hpp"
 #include "engine/resource-system/include.hpp"
+#include "engine/sfml/sprite-system/include.hpp"
+#include "ResourceIds.hpp"
 
 #include "engine/utils/debug/xtrace.hpp"
 
@@ -15,10 +18,10 @@ using engine::resourcesystem::ResourceStorage;
 void renderAllyPokemon(
     sf::RenderWindow& window,
     Camera& camera,
-    ResourceStorage& storage,
+    PokemonSpriteCache& spriteCache,
     Pokemon& pokemon
 ) {
-    sf::Sprite sprite(storage.get<sf::Texture>("pokemon-back-" + pokemon.species));
+    sf::Sprite sprite = spriteCache.get(pokemon.species, SpriteSide::Back);
     float scaledHeight = camera.height / 5;
     sprite.scale(scaledHeight / 64, scaledHeight / 64);
     sprite.setPosition(camera.width / 10, 3 * camera.height / 5);
@@ -28,10 +31,10 @@ void renderAllyPokemon(
 void renderFoePokemon(
     sf::RenderWindow& window,
     Camera& camera,
-    ResourceStorage& storage,
+    PokemonSpriteCache& spriteCache,
     Pokemon& pokemon
 ) {
-    sf::Sprite sprite(storage.get<sf::Texture>("pokemon-front-" + pokemon.species));
+    sf::Sprite sprite = spriteCache.get(pokemon.species, SpriteSide::Front);
     float scaledHeight = camera.height / 5;
     sprite.scale(scaledHeight / 64, scaledHeight / 64);
     sprite.setPosition(7 * camera.width / 10, camera.height / 10);
@@ -132,17 +135,23 @@ void renderInfoCard(
 void renderBattle(
     sf::RenderWindow& window,
     engine::entitysystem::ComponentManager& manager,
-    ResourceStorage& storage
+    ResourceStorage& storage,
+    engine::resourcesystem::ResourceHandle<PokemonSpriteCache> spriteCache
 ) {
     using engine::entitysystem::Entity;
+    using engine::spritesystem::AtlasRegion;
 
-    manager.forEachEntity<Battle>(
+    manager.query<Battle>().forEach(
         [&](
             Entity entity,
             Battle& battle
         ) {
             Camera& camera = storage.get<Camera>("camera");
-            sf::Sprite background(storage.get<sf::Texture>("battle-bg-1"));
+            auto& backgroundRegion = storage.get<AtlasRegion>("battle-bg-1");
+            sf::Sprite background(
+                storage.get<sf::Texture>(backgroundRegion.page),
+                backgroundRegion.rect
+            );
             background.setScale(camera.width / 512.0, camera.height / 288.0);
             background.setPosition(0, 0);
             window.draw(background);
@@ -150,7 +159,7 @@ void renderBattle(
             // TODO: handle Double Battles
             if (!manager.hasComponent<Fainted>(battle.playerTeam[0])) {
                 Pokemon& playerPokemon = manager.getData<Pokemon>(battle.playerTeam[0]);
-                renderAllyPokemon(window, camera, storage, playerPokemon);
+                renderAllyPokemon(window, camera, storage.get(spriteCache), playerPokemon);
                 renderInfoCard(
                     window,
                     storage,
@@ -163,7 +172,7 @@ void renderBattle(
 
             if (!manager.hasComponent<Fainted>(battle.opponentTeam[0])) {
                 Pokemon& opponentPokemon = manager.getData<Pokemon>(battle.opponentTeam[0]);
-                renderFoePokemon(window, camera, storage, opponentPokemon);
+                renderFoePokemon(window, camera, storage.get(spriteCache), opponentPokemon);
                 renderInfoCard(
                     window,
                     storage,
@@ -0,0 +1,226 @@
+#include "engine/resource-system/ResourceLoader.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace engine::resourcesystem;
+
+ResourceLoader::ResourceLoader(size_t numThreads)
+ : numThreads(std::max<size_t>(1, numThreads)) { }
+
+ResourceLoader::~ResourceLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    loadAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ResourceLoader::add(
+    const std::string& name,
+    const std::vector<std::string>& dependencies,
+    Step load,
+    Step commit
+) {
+    if (started) {
+        throw std::logic_error("cannot add task '" + name + "' to a started loader");
+    }
+
+    if (!taskIndexes.insert({name, tasks.size()}).second) {
+        throw std::logic_error("duplicate loading task '" + name + "'");
+    }
+
+    tasks.push_back({name, dependencies, std::move(load), std::move(commit), {}, 0});
+}
+
+void ResourceLoader::setProgressCallback(ProgressCallback callback) {
+    progressCallback = std::move(callback);
+}
+
+void ResourceLoader::start() {
+    if (started) {
+        return;
+    }
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        for (auto& dependency : tasks[i].dependencies) {
+            auto it = taskIndexes.find(dependency);
+
+            if (it == taskIndexes.end()) {
+                throw std::logic_error(
+                    "loading task '" + tasks[i].name
+                    + "' depends on unknown task '" + dependency + "'"
+                );
+            }
+
+            tasks[it->second].dependents.push_back(i);
+        }
+
+        tasks[i].remainingDependencies = tasks[i].dependencies.size();
+    }
+
+    // Kahn's algorithm: if some task is never reached, it's part of a cycle
+    std::vector<size_t> remaining(tasks.size());
+    std::vector<size_t> ready;
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        remaining[i] = tasks[i].remainingDependencies;
+
+        if (remaining[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    size_t numVisited = 0;
+
+    while (!ready.empty()) {
+        size_t index = ready.back();
+        ready.pop_back();
+        ++numVisited;
+
+        for (size_t dependent : tasks[index].dependents) {
+            if (--remaining[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    if (numVisited != tasks.size()) {
+        throw std::logic_error("loading tasks have a dependency cycle");
+    }
+
+    started = true;
+    currentProgress = {0, tasks.size(), ""};
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].remainingDependencies == 0) {
+            schedule(i);
+        }
+    }
+
+    size_t numWorkers = std::min(numThreads, tasks.size());
+
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+bool ResourceLoader::update() {
+    if (!started) {
+        start();
+    }
+
+    std::deque<size_t> ready;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        ready.swap(pendingCommits);
+    }
+
+    for (size_t index : ready) {
+        Task& task = tasks[index];
+
+        if (task.commit) {
+            task.commit();
+        }
+
+        for (size_t dependent : task.dependents) {
+            if (--tasks[dependent].remainingDependencies == 0) {
+                schedule(dependent);
+            }
+        }
+
+        // The steps may hold large buffers, which are no longer needed
+        task.load = nullptr;
+        task.commit = nullptr;
+
+        ++currentProgress.completed;
+        currentProgress.current = task.name;
+
+        if (progressCallback) {
+            progressCallback(currentProgress);
+        }
+    }
+
+    return currentProgress.finished();
+}
+
+void ResourceLoader::wait() {
+    while (!update()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        loadFinished.wait(lock, [this] {
+            return !pendingCommits.empty() || error;
+        });
+    }
+}
+
+const LoadingProgress& ResourceLoader::progress() const {
+    return currentProgress;
+}
+
+size_t ResourceLoader::size() const {
+    return numThreads;
+}
+
+size_t ResourceLoader::defaultNumThreads() {
+    // hardware_concurrency() returns 0 if it can't tell
+    size_t numHardwareThreads = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, numHardwareThreads) - (numHardwareThreads > 1);
+}
+
+void ResourceLoader::schedule(size_t taskIndex) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingLoads.push_back(taskIndex);
+    }
+
+    loadAvailable.notify_one();
+}
+
+void ResourceLoader::workerLoop() {
+    while (true) {
+        size_t index;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            loadAvailable.wait(lock, [this] {
+                return stopping || !pendingLoads.empty();
+            });
+
+            if (stopping) {
+                return;
+            }
+
+            index = pendingLoads.front();
+            pendingLoads.pop_front();
+        }
+
+        // Only this thread accesses the task until it's queued for commit
+        try {
+            if (tasks[index].load) {
+                tasks[index].load();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingCommits.push_back(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        loadFinished.notify_all();
+    }
+}
@@ -0,0 +1,166 @@
+#include "engine/utils/threading/ThreadPool.hpp"
+
+#include <algorithm>
+
+using namespace engine::utils;
+
+namespace {
+    // The pool whose job the current thread is running, used to detect
+    // nested loops, which would otherwise wait on the job they're part of
+    thread_local const ThreadPool* runningPool = nullptr;
+}
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    numThreads = std::max<size_t>(1, numThreads);
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (size_t i = 1; i < numThreads; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+
+    jobAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return queues.size();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize, const RangeFunction& fn) {
+    grainSize = std::max<size_t>(1, grainSize);
+    size_t numRanges = (count + grainSize - 1) / grainSize;
+
+    if (runningPool == this) {
+        for (size_t begin = 0; begin < count; begin += grainSize) {
+            fn(begin, std::min(count, begin + grainSize));
+        }
+        return;
+    }
+
+    if (numRanges <= 1 || workers.empty()) {
+        if (count > 0) {
+            fn(0, count);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(jobMutex);
+    job = &fn;
+    error = nullptr;
+    remainingRanges = numRanges;
+
+    // Each queue initially gets a contiguous block of ranges, which keeps
+    // memory accesses sequential unless work has to be stolen
+    size_t rangesPerQueue = (numRanges + queues.size() - 1) / queues.size();
+
+    for (size_t i = 0; i < queues.size(); ++i) {
+        std::lock_guard<std::mutex> lock(queues[i]->mutex);
+        size_t firstRange = i * rangesPerQueue;
+        size_t lastRange = std::min(numRanges, firstRange + rangesPerQueue);
+
+        for (size_t r = firstRange; r < lastRange; ++r) {
+            queues[i]->ranges.push_back({r * grainSize, std::min(count, (r + 1) * grainSize)});
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        ++generation;
+    }
+
+    jobAvailable.notify_all();
+    runAvailableRanges(0);
+
+    std::unique_lock<std::mutex> lock(stateMutex);
+    jobFinished.wait(lock, [this] { return remainingRanges == 0; });
+    job = nullptr;
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop(size_t queueIndex) {
+    size_t lastGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            jobAvailable.wait(lock, [&] {
+                return stopping || generation != lastGeneration;
+            });
+
+            if (stopping) {
+                return;
+            }
+
+            lastGeneration = generation;
+        }
+
+        runAvailableRanges(queueIndex);
+    }
+}
+
+void ThreadPool::runAvailableRanges(size_t queueIndex) {
+    Range range;
+    const ThreadPool* previousPool = runningPool;
+    runningPool = this;
+
+    while (popRange(queueIndex, range)) {
+        try {
+            (*job)(range.begin, range.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        if (--remainingRanges == 0) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            jobFinished.notify_all();
+        }
+    }
+
+    runningPool = previousPool;
+}
+
+bool ThreadPool::popRange(size_t queueIndex, Range& range) {
+    {
+        WorkQueue& ownQueue = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(ownQueue.mutex);
+
+        if (!ownQueue.ranges.empty()) {
+            range = ownQueue.ranges.front();
+            ownQueue.ranges.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkQueue& victim = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.ranges.empty()) {
+            range = victim.ranges.back();
+            victim.ranges.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,137 @@
+#include "engine/utils/timing/count-allocations.hpp"
+
+#include <cstdlib>
+#include <new>
+#include "engine/utils/timing/Timeline.hpp"
+
+// Replaces the global allocation functions so that ScopedTimers can count
+// the allocations made while they measure. Only linked into the programs
+// that include count-allocations.hpp.
+
+namespace {
+    thread_local size_t numAllocations = 0;
+
+    // Hands the counter to the timers when the program starts
+    struct CounterRegistration {
+        CounterRegistration() {
+            engine::utils::__detail::allocationCounter = engine::utils::allocationCount;
+        }
+    } registration;
+
+    void* allocate(std::size_t size) {
+        ++numAllocations;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+        ++numAllocations;
+        size_t align = static_cast<size_t>(alignment);
+        // aligned_alloc() needs a multiple of the alignment
+        return std::aligned_alloc(align, size == 0 ? align : (size + align - 1) / align * align);
+    }
+
+    void* allocateOrThrow(std::size_t size) {
+        void* pointer = allocate(size);
+
+        while (!pointer) {
+            std::new_handler handler = std::get_new_handler();
+
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+
+            handler();
+            pointer = std::malloc(size == 0 ? 1 : size);
+        }
+
+        return pointer;
+    }
+}
+
+size_t engine::utils::allocationCount() {
+    return numAllocations;
+}
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,238 @@
+#include "init/asset-tables.hpp"
+
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include "engine/resource-system/binary/MappedFile.hpp"
+#include "engine/resource-system/json/include.hpp"
+#include "engine/utils/timing/Timeline.hpp"
+#include "ResourceFiles.hpp"
+
+namespace {
+    using engine::utils::ScopedTimer;
+
+    // Moves learned by level, written as { "level": 1, "move": "Tackle" }
+    struct LevelMoveBinding {
+        using LevelMove = std::pair<int, std::string>;
+
+        static constexpr auto fields = std::make_tuple(
+            jsonField("level", &LevelMove::first),
+            jsonField("move", &LevelMove::second)
+        );
+    };
+
+    // Streams a table file into its records, without building a document
+    template<typename Record>
+    AssetTable<Record> readTableFile(const std::string& filename) {
+        engine::resourcesystem::MappedFile file(filename);
+        ScopedTimer::recordBytesRead(file.size());
+        AssetTable<Record> records;
+        bindJSON(std::string_view(file.data(), file.size()), records);
+        return records;
+    }
+
+    template<typename Record>
+    AssetTable<Record> readTable(const JsonValue& data) {
+        AssetTable<Record> records;
+        bindJSON(data, records);
+        return records;
+    }
+
+    // Encounters are grouped by environment directly in each map's object
+    using EnvironmentEncounters = std::unordered_map<MapEncounterData::Environment, std::vector<EncounterData>>;
+
+    AssetTable<MapEncounterData> toMapEncounters(AssetTable<EnvironmentEncounters>&& table) {
+        AssetTable<MapEncounterData> encounters;
+        encounters.reserve(table.size());
+
+        for (auto& [mapId, environments] : table) {
+            encounters.emplace_back(std::move(mapId), MapEncounterData{std::move(environments)});
+        }
+
+        return encounters;
+    }
+
+    AssetTable<Move> withIds(AssetTable<Move>&& moves) {
+        for (auto& [id, move] : moves) {
+            move.id = id;
+        }
+
+        return std::move(moves);
+    }
+}
+
+template<>
+struct JsonBinding<sf::IntRect> {
+    static constexpr auto elements = std::make_tuple(
+        &sf::IntRect::left,
+        &sf::IntRect::top,
+        &sf::IntRect::width,
+        &sf::IntRect::height
+    );
+};
+
+template<>
+struct JsonBinding<TileData> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("texture", &TileData::texture),
+        jsonField("rect", &TileData::rect)
+    );
+};
+
+template<>
+struct JsonBinding<engine::spritesystem::Frame> {
+    using Frame = engine::spritesystem::Frame;
+
+    static constexpr auto elements = std::make_tuple(
+        &Frame::x,
+        &Frame::y,
+        &Frame::width,
+        &Frame::height,
+        &Frame::lengthInMilliseconds
+    );
+};
+
+template<>
+struct JsonBinding<AnimationRecord> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("texture", &AnimationRecord::texture),
+        jsonField("frames", &AnimationRecord::frames)
+    );
+};
+
+template<>
+struct JsonBinding<EvolutionData> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("pokemon", &EvolutionData::pokemon),
+        // Kept as JSON
+        jsonField("method", &EvolutionData::method)
+    );
+};
+
+template<>
+struct JsonBinding<PokemonSpeciesData> {
+    using Species = PokemonSpeciesData;
+
+    static constexpr auto fields = std::make_tuple(
+        jsonField("display-name", &Species::displayName),
+        jsonField("national-number", &Species::nationalNumber),
+        jsonField("types", &Species::types),
+        jsonField("base-stats", &Species::baseStats),
+        jsonField("male-ratio", &Species::maleRatio),
+        jsonField("growth-rate", &Species::growthRate),
+        jsonField("base-exp", &Species::baseExp),
+        jsonField("effort-points", &Species::effortPoints),
+        jsonField("capture-rate", &Species::captureRate),
+        jsonField("base-happiness", &Species::baseHappiness),
+        jsonField("abilities", &Species::abilities),
+        jsonField("hidden-abilities", &Species::hiddenAbilities),
+        jsonField<LevelMoveBinding>("moves", &Species::moves),
+        jsonOptional("egg-moves", &Species::eggMoves),
+        jsonField("egg-groups", &Species::eggGroups),
+        jsonField("egg-steps", &Species::eggSteps),
+        // Written as strings, like "0.7"
+        jsonField("height", &Species::height),
+        jsonField("weight", &Species::weight),
+        jsonField("color", &Species::color),
+        jsonField("shape", &Species::shape),
+        jsonField("habitat", &Species::habitat),
+        jsonField("kind", &Species::kind),
+        jsonField("pokedex-description", &Species::pokedexDescription),
+        jsonField("battle-player-y", &Species::battlePlayerY),
+        jsonField("battle-enemy-y", &Species::battleEnemyY),
+        jsonField("battle-altitude", &Species::battleAltitude),
+        jsonOptional("evolutions", &Species::evolutions)
+    );
+};
+
+// The id of a move is its key in the table
+template<>
+struct JsonBinding<Move> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("display-name", &Move::displayName),
+        jsonField("type", &Move::type),
+        jsonField("kind", &Move::kind),
+        jsonField("function-code", &Move::functionCode),
+        jsonField("function-parameter", &Move::functionParameter),
+        jsonField("power", &Move::power),
+        jsonField("accuracy", &Move::accuracy),
+        jsonField("pp", &Move::pp),
+        jsonField("effect-rate", &Move::effectRate),
+        jsonField("target-type", &Move::targetType),
+        jsonField("priority", &Move::priority),
+        jsonField("flags", &Move::flags),
+        jsonField("description", &Move::description)
+    );
+};
+
+template<>
+struct JsonBinding<EncounterData> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("pokemon", &EncounterData::pokemon),
+        jsonField("min-level", &EncounterData::minLevel),
+        jsonField("max-level", &EncounterData::maxLevel),
+        jsonField("rate", &EncounterData::rate)
+    );
+};
+
+// The second layer lists x, y and tile id of each tile
+template<>
+struct JsonBinding<MapRecord> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("id", &MapRecord::id),
+        jsonField("name", &MapRecord::name),
+        jsonField("width-in-tiles", &MapRecord::widthInTiles),
+        jsonField("height-in-tiles", &MapRecord::heightInTiles),
+        jsonField("layer1", &MapRecord::layer1),
+        jsonField("layer2", &MapRecord::layer2)
+    );
+};
+
+AssetTable<TileData> readTilesJSON() {
+    return readTableFile<TileData>(ResourceFiles::TILES);
+}
+
+AssetTable<TileData> readTilesJSON(const JsonValue& data) {
+    return readTable<TileData>(data);
+}
+
+AssetTable<AnimationRecord> readAnimationsJSON() {
+    return readTableFile<AnimationRecord>(ResourceFiles::ANIMATIONS);
+}
+
+AssetTable<AnimationRecord> readAnimationsJSON(const JsonValue& data) {
+    return readTable<AnimationRecord>(data);
+}
+
+AssetTable<PokemonSpeciesData> readSpeciesJSON() {
+    return readTableFile<PokemonSpeciesData>(ResourceFiles::POKEMON);
+}
+
+AssetTable<PokemonSpeciesData> readSpeciesJSON(const JsonValue& data) {
+    return readTable<PokemonSpeciesData>(data);
+}
+
+AssetTable<Move> readMovesJSON() {
+    return withIds(readTableFile<Move>(ResourceFiles::MOVES));
+}
+
+AssetTable<Move> readMovesJSON(const JsonValue& data) {
+    return withIds(readTable<Move>(data));
+}
+
+AssetTable<MapEncounterData> readEncountersJSON() {
+    return toMapEncounters(readTableFile<EnvironmentEncounters>(ResourceFiles::ENCOUNTERS));
+}
+
+AssetTable<MapEncounterData> readEncountersJSON(const JsonValue& data) {
+    return toMapEncounters(readTable<EnvironmentEncounters>(data));
+}
+
+AssetTable<MapRecord> readMapsJSON() {
+    return readTableFile<MapRecord>(ResourceFiles::MAPS);
+}
+
+AssetTable<MapRecord> readMapsJSON(const JsonValue& data) {
+    return readTable<MapRecord>(data);
+}
@@ -5,10 +5,13 @@
 #include <unordered_map>
 #include "engine/input-system/include.hpp"
 #include "engine/resource-system/json/include.hpp"
+#include "engine/utils/timing/Timeline.hpp"
 #include "RawInputSFML.hpp"
 
 engine::inputsystem::InputTracker loadInputTracker(const std::string& controlsFileName) {
     using namespace engine::inputsystem;
+    engine::utils::ScopedTimer timer("input tracker");
+    engine::utils::ScopedTimer::recordFileRead(controlsFileName);
     std::ifstream controlsFile(controlsFileName);
 
     auto keyMappingJson = parseJSON(controlsFile);
@@ -16,10 +19,11 @@ engine::inputsystem::InputTracker loadInputTracker(const std::string& controlsFi
 
     for (const auto& [keyboardKey, gameKey] : keyMappingJson.asIterableMap()) {
         keyMapping.insert({
-            keyFromString(keyboardKey),
+            keyFromString(std::string(keyboardKey)),
             gameKey.asString()
         });
     }
 
+    timer.addItems(keyMapping.size());
     return InputTracker(std::make_unique<RawInputSFML>(), keyMapping);
 }
@@ -1,166 +1,323 @@
 #include "init/load-resources.hpp"
 
-#include <algorithm>
 #include <cassert>
-#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
-#include "battle/data/EncounterData.hpp"
-#include "battle/data/Move.hpp"
-#include "battle/data/PokemonSpeciesData.hpp"
+#include "AssetPack.hpp"
 #include "battle/helpers/move-effects.hpp"
+#include "battle/PokemonSpriteCache.hpp"
 #include "components/Map.hpp"
+#include "engine/resource-system/binary/MappedFile.hpp"
 #include "engine/resource-system/include.hpp"
 #include "engine/resource-system/json/include.hpp"
 #include "engine/scripting-system/include.hpp"
 #include "engine/sfml/sound-system/include.hpp"
 #include "engine/sfml/sprite-system/include.hpp"
+#include "engine/utils/timing/Timeline.hpp"
+#include "init/asset-tables.hpp"
 #include "lua-native-functions.hpp"
 #include "ResourceFiles.hpp"
+#include "ResourceIds.hpp"
 #include "Settings.hpp"
 #include "TileData.hpp"
 
 #include "engine/utils/debug/xtrace.hpp"
 
+using engine::resourcesystem::ResourceLoader;
 using engine::resourcesystem::ResourceStorage;
+using engine::scriptingsystem::Lua;
+using engine::utils::ScopedTimer;
+
+namespace {
+    // Loaded data waiting to be committed, shared between the two steps of
+    // a task. The load step fills it on a worker thread.
+    template<typename T>
+    using Pending = std::shared_ptr<std::vector<std::pair<std::string, T>>>;
+
+    template<typename T>
+    Pending<T> pending() {
+        return std::make_shared<std::vector<std::pair<std::string, T>>>();
+    }
 
-void loadFonts(ResourceStorage& storage) {
-    std::ifstream fontsFile(ResourceFiles::FONTS);
-    JsonValue data = parseJSON(fontsFile);
+    JsonValue parseJSONFile(const std::string& filename) {
+        engine::resourcesystem::MappedFile file(filename);
+        ScopedTimer::recordBytesRead(file.size());
+        return parseJSON(std::string_view(file.data(), file.size()));
+    }
 
-    for (const auto& [id, path] : data.asIterableMap()) {
-        sf::Font font;
-        assert(font.loadFromFile(path.asString()));
-        storage.store(id, font);
+    // Reads a table from the asset pack if it was baked from the current
+    // JSON file, and from the JSON file otherwise
+    template<typename T>
+    AssetTable<T> readTable(
+        const std::shared_ptr<const AssetPack>& pack,
+        AssetSection section,
+        AssetTable<T> (AssetPack::*fromPack)() const,
+        AssetTable<T> (*fromJSON)()
+    ) {
+        if (pack && pack->isUpToDate(section)) {
+            // A corrupt section throws std::out_of_range or, for an unknown
+            // JSON tag, std::runtime_error
+            try {
+                return (pack.get()->*fromPack)();
+            } catch (const std::exception& error) {
+                ECHO("[RESOURCE] Asset pack section not used: " + std::string(error.what()));
+            }
+        }
+
+        return fromJSON();
     }
 
-    ECHO("[RESOURCE] Fonts: OK");
+    std::shared_ptr<const AssetPack> openAssetPack(ResourceStorage& storage) {
+        ScopedTimer timer("asset pack");
+        std::string filename = storage.get<Settings>("settings").getAssetPackFile();
+
+        try {
+            return std::make_shared<const AssetPack>(filename);
+        } catch (const std::runtime_error& error) {
+            ECHO("[RESOURCE] Asset pack not used: " + std::string(error.what()));
+            return nullptr;
+        }
+    }
 }
 
-void loadTextures(ResourceStorage& storage) {
-    std::ifstream texturesFile(ResourceFiles::TEXTURES);
-    JsonValue data = parseJSON(texturesFile);
+void loadFonts(ResourceLoader& loader, ResourceStorage& storage) {
+    auto fonts = pending<sf::Font>();
 
-    for (const auto& [id, path] : data.asIterableMap()) {
-        sf::Texture texture;
-        assert(texture.loadFromFile(path.asString()));
-        storage.store(id, texture);
-    }
+    loader.add("fonts", {}, [fonts] {
+        ScopedTimer timer("fonts: load");
+        JsonValue data = parseJSONFile(ResourceFiles::FONTS);
+
+        for (const auto& [id, path] : data.asIterableMap()) {
+            sf::Font font;
+            ScopedTimer::recordFileRead(path.asString());
+            assert(font.loadFromFile(path.asString()));
+            fonts->emplace_back(id, font);
+        }
+
+        timer.addItems(fonts->size());
+    }, [fonts, &storage] {
+        ScopedTimer timer("fonts: commit");
+        timer.addItems(fonts->size());
+
+        for (auto& [id, font] : *fonts) {
+            storage.store(id, std::move(font));
+        }
 
-    ECHO("[RESOURCE] Textures: OK");
+        ECHO("[RESOURCE] Fonts: OK");
+    });
 }
 
-void loadAnimationData(ResourceStorage& storage) {
+void loadTextures(ResourceLoader& loader, ResourceStorage& storage) {
     using namespace engine::spritesystem;
+    auto atlas = std::make_shared<TextureAtlas>();
+    unsigned maxAtlasSize = storage.get<Settings>("settings").getMaxAtlasSize();
 
-    std::ifstream animationsFile(ResourceFiles::ANIMATIONS);
-    JsonValue data = parseJSON(animationsFile);
-
-    for (const auto& [id, animationData] : data.asIterableMap()) {
-        sf::Sprite sprite(
-            storage.get<sf::Texture>(
-                animationData["texture"].asString()
-            )
-        );
-
-        const JsonValue& jsonFrames = animationData["frames"];
-        std::vector<Frame> frames;
-
-        for (const auto& frameData : jsonFrames.asIterableArray()) {
-            frames.push_back({
-                frameData[0].asInt(),
-                frameData[1].asInt(),
-                frameData[2].asInt(),
-                frameData[3].asInt(),
-                frameData[4].asInt()
-            });
-        }
+    loader.add("textures", {}, [atlas, maxAtlasSize] {
+        ScopedTimer timer("textures: load");
+        JsonValue data = parseJSONFile(ResourceFiles::TEXTURES);
+        std::vector<std::pair<std::string, sf::Image>> images;
 
-        storage.store(id, LoopingAnimationData { sprite, frames });
-    }
+        for (const auto& [id, path] : data.asIterableMap()) {
+            sf::Image image;
+            ScopedTimer::recordFileRead(path.asString());
 
-    ECHO("[RESOURCE] Animations: OK");
-}
+            if (!image.loadFromFile(path.asString())) {
+                throw std::runtime_error("Failed to load texture: " + path.asString());
+            }
 
-void loadSoundEffects(ResourceStorage& storage) {
-    std::ifstream sfxFile(ResourceFiles::SOUND_EFFECTS);
-    JsonValue data = parseJSON(sfxFile);
+            images.emplace_back(id, std::move(image));
+        }
 
-    for (const auto& [id, path] : data.asIterableMap()) {
-        sf::SoundBuffer buffer;
-        assert(buffer.loadFromFile(path.asString()));
-        storage.store("buffer-" + id, buffer);
-        storage.store(id, sf::Sound(storage.get<sf::SoundBuffer>("buffer-" + id)));
-    }
+        *atlas = packAtlas("atlas", images, maxAtlasSize);
 
-    ECHO("[RESOURCE] Sound Effects: OK");
-}
+        timer.addItems(atlas->regions.size());
+    }, [atlas, &storage] {
+        ScopedTimer timer("textures: commit");
+        timer.addItems(atlas->regions.size());
 
-void loadBGM(ResourceStorage& storage) {
-    std::ifstream bgmFile(ResourceFiles::BGM);
-    JsonValue data = parseJSON(bgmFile);
+        for (auto& [id, page] : atlas->pages) {
+            sf::Texture texture;
 
-    for (const auto& [id, bgmData] : data.asIterableMap()) {
-        engine::soundsystem::Music bgmWrapper;
-        sf::Music& bgm = bgmWrapper.get();
-        auto bgmSettings = bgmData.get<std::unordered_map<std::string, JsonValue>>();
-        assert(bgm.openFromFile(bgmSettings["file"].asString()));
+            if (!texture.loadFromImage(page)) {
+                throw std::runtime_error("Failed to upload atlas page: " + id);
+            }
 
-        float loopStart = 0;
-        if (bgmSettings.count("loop-start")) {
-            loopStart = std::stof(bgmSettings["loop-start"].asString());
+            storage.store(id, texture);
         }
 
-        float loopEnd = bgm.getDuration().asSeconds();
-        if (bgmSettings.count("loop-end")) {
-            loopEnd = std::stof(bgmSettings["loop-end"].asString());
+        // Textures are looked up by their own id to find where they were
+        // packed
+        for (auto& [id, region] : atlas->regions) {
+            storage.store(id, std::move(region));
         }
 
-        bgm.setLoopPoints({sf::seconds(loopStart), sf::seconds(loopEnd - loopStart)});
+        ECHO("[RESOURCE] Textures: OK (" + std::to_string(atlas->pages.size()) + " atlas pages)");
+    });
+}
+
+void loadAnimationData(
+    ResourceLoader& loader,
+    ResourceStorage& storage,
+    std::shared_ptr<const AssetPack> pack
+) {
+    using namespace engine::spritesystem;
+    auto animations = std::make_shared<AssetTable<AnimationRecord>>();
+
+    loader.add("animations", {"textures"}, [animations, pack] {
+        ScopedTimer timer("animations: load");
+        *animations = readTable(pack, AssetSection::Animations, &AssetPack::animations, readAnimationsJSON);
+
+        timer.addItems(animations->size());
+    }, [animations, &storage] {
+        ScopedTimer timer("animations: commit");
+        timer.addItems(animations->size());
+
+        for (auto& [id, animation] : *animations) {
+            AtlasRegion& region = storage.get<AtlasRegion>(animation.texture);
+
+            for (Frame& frame : animation.frames) {
+                frame.x += region.rect.left;
+                frame.y += region.rect.top;
+            }
+
+            sf::Sprite sprite(storage.get<sf::Texture>(region.page));
 
-        if (bgmSettings.count("start-offset")) {
-            float startOffset = std::stof(bgmSettings["start-offset"].asString());
-            bgm.setPlayingOffset(sf::seconds(startOffset));
+            // Otherwise the whole page is shown until the animation plays
+            if (!animation.frames.empty()) {
+                const Frame& frame = animation.frames.front();
+                sprite.setTextureRect({frame.x, frame.y, frame.width, frame.height});
+            }
+
+            storage.store(id, LoopingAnimationData { sprite, std::move(animation.frames) });
         }
 
-        if (bgmSettings.count("volume")) {
-            float volume = std::stof(bgmSettings["volume"].asString());
-            bgm.setVolume(volume);
+        ECHO("[RESOURCE] Animations: OK");
+    });
+}
+void loadSoundEffects(ResourceLoader& loader, ResourceStorage& storage) {
+    auto buffers = pending<sf::SoundBuffer>();
+
+    loader.add("sound-effects", {}, [buffers] {
+        ScopedTimer timer("sound-effects: load");
+        JsonValue data = parseJSONFile(ResourceFiles::SOUND_EFFECTS);
+
+        for (const auto& [id, path] : data.asIterableMap()) {
+            sf::SoundBuffer buffer;
+            ScopedTimer::recordFileRead(path.asString());
+            assert(buffer.loadFromFile(path.asString()));
+            buffers->emplace_back(id, std::move(buffer));
         }
 
-        bgm.setLoop(true);
-        storage.store(id, std::move(bgmWrapper));
-    }
+        timer.addItems(buffers->size());
+    }, [buffers, &storage] {
+        ScopedTimer timer("sound-effects: commit");
+        timer.addItems(buffers->size());
+
+        for (auto& [id, buffer] : *buffers) {
+            storage.store("buffer-" + id, std::move(buffer));
+            storage.store(id, sf::Sound(storage.get<sf::SoundBuffer>("buffer-" + id)));
+        }
 
-    ECHO("[RESOURCE] BGM: OK");
+        ECHO("[RESOURCE] Sound Effects: OK");
+    });
 }
 
-void loadTiles(ResourceStorage& storage) {
-    std::ifstream tilesFile(ResourceFiles::TILES);
-    JsonValue data = parseJSON(tilesFile);
-
-    for (const auto& [id, tileData] : data.asIterableMap()) {
-        storage.store<TileData>("tile-" + id, {
-            tileData["texture"].asString(),
-            {
-                tileData["rect"][0].asInt(),
-                tileData["rect"][1].asInt(),
-                tileData["rect"][2].asInt(),
-                tileData["rect"][3].asInt()
+void loadBGM(ResourceLoader& loader, ResourceStorage& storage) {
+    auto bgms = pending<engine::soundsystem::Music>();
+
+    loader.add("bgm", {}, [bgms] {
+        ScopedTimer timer("bgm: load");
+        JsonValue data = parseJSONFile(ResourceFiles::BGM);
+
+        for (const auto& [id, bgmData] : data.asIterableMap()) {
+            engine::soundsystem::Music bgmWrapper;
+            sf::Music& bgm = bgmWrapper.get();
+            auto bgmSettings = bgmData.get<std::unordered_map<std::string, JsonValue>>();
+            // Music is streamed, so only its header is read here
+            assert(bgm.openFromFile(bgmSettings["file"].asString()));
+
+            float loopStart = 0;
+            if (bgmSettings.count("loop-start")) {
+                loopStart = static_cast<float>(bgmSettings["loop-start"].asDouble());
             }
-        });
-    }
 
-    ECHO("[RESOURCE] TILES: OK");
+            float loopEnd = bgm.getDuration().asSeconds();
+            if (bgmSettings.count("loop-end")) {
+                loopEnd = static_cast<float>(bgmSettings["loop-end"].asDouble());
+            }
+
+            bgm.setLoopPoints({sf::seconds(loopStart), sf::seconds(loopEnd - loopStart)});
+
+            if (bgmSettings.count("start-offset")) {
+                float startOffset = static_cast<float>(bgmSettings["start-offset"].asDouble());
+                bgm.setPlayingOffset(sf::seconds(startOffset));
+            }
+
+            if (bgmSettings.count("volume")) {
+                float volume = static_cast<float>(bgmSettings["volume"].asDouble());
+                bgm.setVolume(volume);
+            }
+
+            bgm.setLoop(true);
+            bgms->emplace_back(id, std::move(bgmWrapper));
+        }
+
+        timer.addItems(bgms->size());
+    }, [bgms, &storage] {
+        ScopedTimer timer("bgm: commit");
+        timer.addItems(bgms->size());
+
+        for (auto& [id, bgm] : *bgms) {
+            storage.store(id, std::move(bgm));
+        }
+
+        ECHO("[RESOURCE] BGM: OK");
+    });
 }
 
+void moveToAtlas(TileData& tile, ResourceStorage& storage) {
+    auto& region = storage.get<engine::spritesystem::AtlasRegion>(tile.texture);
+    tile.texture = region.page;
+    tile.rect.left += region.rect.left;
+    tile.rect.top += region.rect.top;
+}
+
+void loadTiles(
+    ResourceLoader& loader,
+    ResourceStorage& storage,
+    std::shared_ptr<const AssetPack> pack
+) {
+    auto tiles = std::make_shared<AssetTable<TileData>>();
+
+    loader.add("tiles", {"textures"}, [tiles, pack] {
+        ScopedTimer timer("tiles: load");
+        *tiles = readTable(pack, AssetSection::Tiles, &AssetPack::tiles, readTilesJSON);
+
+        timer.addItems(tiles->size());
+    }, [tiles, &storage] {
+        ScopedTimer timer("tiles: commit");
+        timer.addItems(tiles->size());
+
+        for (auto& [id, tile] : *tiles) {
+            moveToAtlas(tile, storage);
+            storage.store("tile-" + id, std::move(tile));
+        }
+
+        ECHO("[RESOURCE] TILES: OK");
+    });
+}
 void loadSequentialTileData(
-    JsonValue tileDataArray,
+    const std::vector<std::string>& tileIds,
     ResourceStorage& storage,
     Map& map
 ) {
-    for (const auto& tileId : tileDataArray.asIterableArray()) {
-        TileData& tileData = storage.get<TileData>("tile-" + tileId.asString());
+    for (const auto& tileId : tileIds) {
+        TileData& tileData = storage.get<TileData>("tile-" + tileId);
         Tile tile;
         tile.sprites.emplace_back(storage.get<sf::Texture>(tileData.texture));
         sf::Sprite& layer1 = tile.sprites.back();
@@ -171,14 +328,12 @@ void loadSequentialTileData(
 }
 
 void loadSparseTileData(
-    JsonValue tileDataArray,
+    const std::vector<std::tuple<int, int, std::string>>& tiles,
     ResourceStorage& storage,
     Map& map
 ) {
-    for (const auto& tileCoordinates : tileDataArray.asIterableArray()) {
-        int x = tileCoordinates[0].asInt();
-        int y = tileCoordinates[1].asInt();
-        TileData& tileData = storage.get<TileData>("tile-" + tileCoordinates[2].asString());
+    for (const auto& [x, y, tileId] : tiles) {
+        TileData& tileData = storage.get<TileData>("tile-" + tileId);
 
         Tile& tile = map.tiles[y * map.widthInTiles + x];
         tile.sprites.emplace_back(storage.get<sf::Texture>(tileData.texture));
@@ -187,231 +342,202 @@ void loadSparseTileData(
     }
 }
 
-void loadScript(ResourceStorage& storage, const std::string& id) {
-    using engine::scriptingsystem::Lua;
+Map buildMap(const MapRecord& record, ResourceStorage& storage) {
+    Map map = {
+        record.id,
+        record.name,
+        record.widthInTiles,
+        record.heightInTiles,
+        {}
+    };
+
+    loadSequentialTileData(record.layer1, storage, map);
+    loadSparseTileData(record.layer2, storage, map);
+    return map;
+}
+
+std::string mapScriptId(const MapRecord& record) {
+    return "map-" + std::to_string(record.id);
+}
+
+std::unique_ptr<Lua> openScript(const std::string& id) {
     std::string filename = ResourceFiles::SCRIPTS_FOLDER + id + ".lua";
-    storage.store(id, Lua(filename));
-    injectNativeFunctions(storage.get<Lua>(id));
-    ECHO("[RESOURCE] Script '" + id + "': OK");
+    ScopedTimer::recordFileRead(filename);
+    return std::make_unique<Lua>(filename);
 }
 
-void loadMaps(ResourceStorage& storage) {
-    std::ifstream mapsFile(ResourceFiles::MAPS);
-    JsonValue data = parseJSON(mapsFile);
-
-    for (const auto& [id, mapData] : data.asIterableMap()) {
-        size_t mapId = static_cast<size_t>(mapData["id"].asInt());
-        Map map = {
-            mapId,
-            mapData["name"].asString(),
-            static_cast<size_t>(mapData["width-in-tiles"].asInt()),
-            static_cast<size_t>(mapData["height-in-tiles"].asInt()),
-            {}
-        };
-
-        loadSequentialTileData(mapData["layer1"], storage, map);
-        loadSparseTileData(mapData["layer2"], storage, map);
-        loadScript(storage, "map-" + std::to_string(mapId));
-
-        storage.store(id, map);
+void injectScriptFunctions(const std::string& id, Lua& script) {
+    injectNativeFunctions(script);
+
+    if (id == "moves") {
+        injectNativeBattleFunctions(script);
     }
+}
 
-    ECHO("[RESOURCE] Maps: OK");
+void storeScript(ResourceStorage& storage, const std::string& id, Lua&& script) {
+    storage.store(id, std::move(script));
+    injectScriptFunctions(id, storage.get<Lua>(id));
+    ECHO("[RESOURCE] Script '" + id + "': OK");
 }
 
-void loadEncounters(ResourceStorage& storage) {
-    std::ifstream encountersFile(ResourceFiles::ENCOUNTERS);
-    JsonValue data = parseJSON(encountersFile);
+void loadMaps(ResourceLoader& loader, ResourceStorage& storage) {
+    auto maps = std::make_shared<AssetTable<MapRecord>>();
+    auto scripts = pending<std::unique_ptr<Lua>>();
 
-    for (const auto& [mapId, mapEncounterData] : data.asIterableMap()) {
-        MapEncounterData mapEncounters;
+    loader.add("maps", {"textures", "tiles"}, [maps, scripts] {
+        ScopedTimer timer("maps: load");
+        *maps = readMapsJSON();
 
-        for (const auto& [environment, encounterDataArray] : mapEncounterData.asIterableMap()) {
-            std::vector<EncounterData> encounterList;
+        for (const auto& [id, record] : *maps) {
+            std::string scriptId = mapScriptId(record);
+            scripts->emplace_back(scriptId, openScript(scriptId));
+        }
 
-            for (const auto& encounterData : encounterDataArray.asIterableArray()) {
-                EncounterData encounter;
-                encounter.pokemon = encounterData["pokemon"].asString();
-                encounter.minLevel = encounterData["min-level"].asInt();
-                encounter.maxLevel = encounterData["max-level"].asInt();
-                encounter.rate = encounterData["rate"].asInt();
-                encounterList.push_back(encounter);
-            }
+        timer.addItems(maps->size());
+    }, [maps, scripts, &storage] {
+        ScopedTimer timer("maps: commit");
+        timer.addItems(maps->size());
 
-            mapEncounters.encounterData[environment] = encounterList;
+        for (auto& [id, script] : *scripts) {
+            storeScript(storage, id, std::move(*script));
         }
 
-        storage.store("encounters-" + mapId, mapEncounters);
-    }
+        for (const auto& [id, record] : *maps) {
+            storage.store(id, buildMap(record, storage));
+        }
 
-    ECHO("[RESOURCE] Encounters: OK");
+        ECHO("[RESOURCE] Maps: OK");
+    });
 }
 
-std::vector<std::string> asStringVector(const JsonValue& value) {
-    std::vector<std::string> result;
-
-    for (const auto& member : value.asIterableArray()) {
-        result.push_back(member.asString());
-    }
-
-    return result;
-}
+void loadEncounters(
+    ResourceLoader& loader,
+    ResourceStorage& storage,
+    std::shared_ptr<const AssetPack> pack
+) {
+    auto encounters = std::make_shared<AssetTable<MapEncounterData>>();
 
-std::array<int, 6> asStatArray(const JsonValue& value) {
-    std::array<int, 6> result;
-    size_t i = 0;
+    loader.add("encounters", {}, [encounters, pack] {
+        ScopedTimer timer("encounters: load");
+        *encounters = readTable(pack, AssetSection::Encounters, &AssetPack::encounters, readEncountersJSON);
 
-    for (const auto& member : value.asIterableArray()) {
-        result[i] = member.asInt();
-        ++i;
-    }
+        timer.addItems(encounters->size());
+    }, [encounters, &storage] {
+        ScopedTimer timer("encounters: commit");
+        timer.addItems(encounters->size());
 
-    return result;
-}
+        for (auto& [mapId, mapEncounters] : *encounters) {
+            storage.store("encounters-" + mapId, std::move(mapEncounters));
+        }
 
-float asFloat(const JsonValue& value) {
-    return std::stof(value.asString());
+        ECHO("[RESOURCE] Encounters: OK");
+    });
 }
+void loadPokemonSpecies(
+    ResourceLoader& loader,
+    ResourceStorage& storage,
+    std::shared_ptr<const AssetPack> pack
+) {
+    auto speciesList = std::make_shared<AssetTable<PokemonSpeciesData>>();
 
-std::vector<std::pair<int, std::string>> asMoveList(const JsonValue& value) {
-    std::vector<std::pair<int, std::string>> result;
-
-    for (const auto& entry : value.asIterableArray()) {
-        result.push_back({
-            entry["level"].asInt(),
-            entry["move"].asString()
-        });
-    }
+    loader.add("pokemon-species", {}, [speciesList, pack] {
+        ScopedTimer timer("pokemon-species: load");
+        *speciesList = readTable(pack, AssetSection::Species, &AssetPack::species, readSpeciesJSON);
 
-    return result;
-}
+        timer.addItems(speciesList->size());
+    }, [speciesList, &storage] {
+        ScopedTimer timer("pokemon-species: commit");
+        timer.addItems(speciesList->size());
 
-std::vector<EvolutionData> asEvolutionData(const JsonValue& value) {
-    std::vector<EvolutionData> result;
-
-    for (const auto& entry : value.asIterableArray()) {
-        result.push_back({
-            entry["pokemon"].asString(),
-            entry["method"]
-        });
-    }
+        for (auto& [id, species] : *speciesList) {
+            storage.store("pokemon-" + id, std::move(species));
+        }
 
-    return result;
+        ECHO("[RESOURCE] Pokemon: OK");
+    });
 }
-
-std::vector<std::string> loadPokemonSpecies(ResourceStorage& storage) {
-    std::ifstream pokemonFile(ResourceFiles::POKEMON);
-    JsonValue data = parseJSON(pokemonFile);
-    std::vector<std::string> pokemonList;
-
-    for (const auto& [id, pokemonData] : data.asIterableMap()) {
-        PokemonSpeciesData species;
-        species.displayName = pokemonData["display-name"].asString();
-        species.nationalNumber = pokemonData["national-number"].asInt();
-        species.types = asStringVector(pokemonData["types"]);
-        species.baseStats = asStatArray(pokemonData["base-stats"]);
-        species.maleRatio = pokemonData["male-ratio"].asString();
-        species.growthRate = pokemonData["growth-rate"].asString();
-        species.baseExp = pokemonData["base-exp"].asInt();
-        species.effortPoints = asStatArray(pokemonData["effort-points"]);
-        species.captureRate = pokemonData["capture-rate"].asInt();
-        species.baseHappiness = pokemonData["base-happiness"].asInt();
-        species.abilities = asStringVector(pokemonData["abilities"]);
-        species.hiddenAbilities = asStringVector(pokemonData["hidden-abilities"]);
-        species.moves = asMoveList(pokemonData["moves"]);
-        species.eggMoves = asStringVector(pokemonData["egg-moves"]);
-        species.eggGroups = asStringVector(pokemonData["egg-groups"]);
-        species.eggSteps = pokemonData["egg-steps"].asInt();
-        species.height = asFloat(pokemonData["height"]);
-        species.weight = asFloat(pokemonData["weight"]);
-        species.color = pokemonData["color"].asString();
-        species.shape = pokemonData["shape"].asInt();
-        species.habitat = pokemonData["habitat"].asString();
-        species.kind = pokemonData["kind"].asString();
-        species.pokedexDescription = pokemonData["pokedex-description"].asString();
-        species.battlePlayerY = pokemonData["battle-player-y"].asInt();
-        species.battleEnemyY = pokemonData["battle-enemy-y"].asInt();
-        species.battleAltitude = pokemonData["battle-altitude"].asInt();
-        species.evolutions = asEvolutionData(pokemonData["evolutions"]);
-
-        storage.store("pokemon-" + id, species);
-        pokemonList.push_back(id);
-    }
-
-    ECHO("[RESOURCE] Pokemon: OK");
-    return pokemonList;
+void loadPokemonSprites(ResourceLoader& loader, ResourceStorage& storage) {
+    // Sprites are only loaded when first used, so there's nothing to decode
+    // here
+    loader.add("pokemon-sprites", {}, nullptr, [&storage] {
+        ScopedTimer timer("pokemon-sprites: commit");
+        Settings& settings = storage.get<Settings>("settings");
+        storage.store(ResourceIds::POKEMON_SPRITES, PokemonSpriteCache(
+            settings.getPokemonBackSpritesFolder(),
+            settings.getPokemonFrontSpritesFolder(),
+            settings.getPokemonSpriteCacheBudget(),
+            settings.getPokemonSpriteSize()
+        ));
+
+        ECHO("[RESOURCE] Pokemon sprites: OK");
+    });
 }
 
-void loadPokemonSprites(
+void loadMoves(
+    ResourceLoader& loader,
     ResourceStorage& storage,
-    const std::vector<std::string>& pokemonList
+    std::shared_ptr<const AssetPack> pack
 ) {
-    Settings& settings = storage.get<Settings>("settings");
-    std::string backSprites = settings.getPokemonBackSpritesFolder();
-    std::string frontSprites = settings.getPokemonFrontSpritesFolder();
+    auto moves = std::make_shared<AssetTable<Move>>();
 
-    for (const std::string& id : pokemonList) {
-        std::string lowercaseId = id;
-        std::transform(id.begin(), id.end(), lowercaseId.begin(), tolower);
+    loader.add("moves", {}, [moves, pack] {
+        ScopedTimer timer("moves: load");
+        *moves = readTable(pack, AssetSection::Moves, &AssetPack::moves, readMovesJSON);
 
-        sf::Texture backTexture;
-        assert(backTexture.loadFromFile(backSprites + lowercaseId + ".png"));
-        storage.store("pokemon-back-" + id, backTexture);
+        timer.addItems(moves->size());
+    }, [moves, &storage] {
+        ScopedTimer timer("moves: commit");
+        timer.addItems(moves->size());
 
-        sf::Texture frontTexture;
-        assert(frontTexture.loadFromFile(frontSprites + lowercaseId + ".png"));
-        storage.store("pokemon-front-" + id, frontTexture);
-    }
+        for (auto& [id, move] : *moves) {
+            storage.store("move-" + id, std::move(move));
+        }
 
-    ECHO("[RESOURCE] Pokemon sprites: OK");
+        ECHO("[RESOURCE] Moves: OK");
+    });
 }
+void loadBattleScripts(ResourceLoader& loader, ResourceStorage& storage) {
+    auto scripts = pending<std::unique_ptr<Lua>>();
 
-void loadMoves(ResourceStorage& storage) {
-    std::ifstream movesFile(ResourceFiles::MOVES);
-    JsonValue data = parseJSON(movesFile);
-
-    for (const auto& [id, moveData] : data.asIterableMap()) {
-        Move move;
-        move.id = id;
-        move.displayName = moveData["display-name"].asString();
-        move.type = moveData["type"].asString();
-        move.kind = moveData["kind"].asString();
-        move.functionCode = moveData["function-code"].asInt();
-        move.functionParameter = moveData["function-parameter"].asInt();
-        move.power = moveData["power"].asInt();
-        move.accuracy = moveData["accuracy"].asInt();
-        move.pp = moveData["pp"].asInt();
-        move.effectRate = moveData["effect-rate"].asInt();
-        move.targetType = moveData["target-type"].asString();
-        move.priority = moveData["priority"].asInt();
-        move.flags = moveData["flags"].asString();
-        move.description = moveData["description"].asString();
-
-        storage.store("move-" + id, move);
-    }
+    loader.add("battle-scripts", {}, [scripts] {
+        ScopedTimer timer("battle-scripts: load");
+        scripts->emplace_back("ai", openScript("ai"));
+        scripts->emplace_back("moves", openScript("moves"));
+
+        timer.addItems(scripts->size());
+    }, [scripts, &storage] {
+        ScopedTimer timer("battle-scripts: commit");
+        timer.addItems(scripts->size());
+
+        for (auto& [id, script] : *scripts) {
+            storeScript(storage, id, std::move(*script));
+        }
 
-    ECHO("[RESOURCE] Moves: OK");
+        ECHO("[RESOURCE] Battle scripts: OK");
+    });
 }
 
-void loadBattleScripts(ResourceStorage& storage) {
-    using engine::scriptingsystem::Lua;
-    loadScript(storage, "ai");
-    loadScript(storage, "moves");
-    injectNativeBattleFunctions(storage.get<Lua>("moves"));
-    ECHO("[RESOURCE] Battle scripts: OK");
+std::unique_ptr<ResourceLoader> startLoadingResources(ResourceStorage& storage) {
+    auto loader = std::make_unique<ResourceLoader>();
+    std::shared_ptr<const AssetPack> pack = openAssetPack(storage);
+
+    loadFonts(*loader, storage);
+    loadTextures(*loader, storage);
+    loadAnimationData(*loader, storage, pack);
+    loadSoundEffects(*loader, storage);
+    loadBGM(*loader, storage);
+    loadTiles(*loader, storage, pack);
+    loadMaps(*loader, storage);
+    loadEncounters(*loader, storage, pack);
+    loadPokemonSpecies(*loader, storage, pack);
+    loadPokemonSprites(*loader, storage);
+    loadMoves(*loader, storage, pack);
+    loadBattleScripts(*loader, storage);
+
+    loader->start();
+    return loader;
 }
 
 void loadResources(ResourceStorage& storage) {
-    loadFonts(storage);
-    loadTextures(storage);
-    loadAnimationData(storage);
-    loadSoundEffects(storage);
-    loadBGM(storage);
-    loadTiles(storage);
-    loadMaps(storage);
-    loadEncounters(storage);
-    std::vector<std::string> pokemonList = loadPokemonSpecies(storage);
-    loadPokemonSprites(storage, pokemonList);
-    loadMoves(storage);
-    loadBattleScripts(storage);
+    startLoadingResources(storage)->wait();
 }
@@ -2,12 +2,15 @@
 
 #include <memory>
 #include "engine/state-system/include.hpp"
+#include "engine/utils/timing/Timeline.hpp"
 #include "states/BattleState.hpp"
 #include "states/MenuState.hpp"
 #include "states/OverworldState.hpp"
 #include "states/TODOState.hpp"
 
 void registerStates(CoreStructures& gameData) {
+    engine::utils::ScopedTimer timer("states");
+
     gameData.stateMachine->registerState(
         "todo-state",
         std::make_unique<TODOState>()
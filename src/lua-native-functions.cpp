@@ -16,6 +16,7 @@
 #include "overworld/events/PlayerMoveEvent.hpp"
 #include "overworld/events/PlayerSpinningMoveEvent.hpp"
 #include "overworld/overworld-utils.hpp"
+#include "ResourceIds.hpp"
 
 #include "engine/utils/debug/xtrace.hpp"
 
@@ -27,13 +28,13 @@ namespace {
 
     template<typename TEvent, typename... Args>
     void enqueueEvent(Args&&... args) {
-        EventQueue& queue = resource<EventQueue>("player-event-queue", *gameData);
+        EventQueue& queue = resource<EventQueue>(ResourceIds::PLAYER_EVENT_QUEUE, *gameData);
         queue.addEvent(std::make_unique<TEvent>(std::forward<Args>(args)...));
     }
 
     template<typename TEvent, typename... Args>
     void enqueueBattleEvent(Args&&... args) {
-        EventQueue& queue = resource<EventQueue>("battle-event-queue", *gameData);
+        EventQueue& queue = resource<EventQueue>(ResourceIds::BATTLE_EVENT_QUEUE, *gameData);
         queue.addEvent(std::make_unique<TEvent>(std::forward<Args>(args)...));
     }
 
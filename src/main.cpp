@@ -4,6 +4,7 @@
 #include "engine/entity-system/include.hpp"
 #include "engine/game-loop/SingleThreadGameLoop.hpp"
 #include "engine/resource-system/include.hpp"
+#include "engine/utils/threading/ThreadPool.hpp"
 #include "GameLogic.hpp"
 #include "GameRenderer.hpp"
 #include "Settings.hpp"
@@ -12,6 +13,8 @@ int main(int argc, char** argv) {
     // XInitThreads();
     engine::entitysystem::ComponentManager componentManager;
     engine::resourcesystem::ResourceStorage resourceStorage;
+    engine::utils::ThreadPool threadPool;
+    componentManager.setThreadPool(&threadPool);
 
     resourceStorage.store("settings", Settings{});
     Settings& settings = resourceStorage.get<Settings>("settings");
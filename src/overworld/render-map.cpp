@@ -16,7 +16,7 @@ void renderMapLayer(
     static const auto tileSize = storage.get<Settings>("settings").getTileSize();
     auto layerValue = static_cast<size_t>(layer);
 
-    manager.forEachEntity<Map>(
+    manager.query<Map>().forEach(
         [&](
             Entity entity,
             Map& map
@@ -40,23 +40,26 @@ void updateTextBoxVariables(Camera& camera) {
 TextBoxSkinGrid getTextBoxSkinSprites(
     engine::resourcesystem::ResourceStorage& storage
 ) {
-    sf::Texture& textBoxSkin = storage.get<sf::Texture>("text-skin-1");
-    sf::Sprite sprite00(textBoxSkin);
-    sprite00.setTextureRect(sf::IntRect{0, 0, 16, 16});
-    sf::Sprite sprite10(textBoxSkin);
-    sprite10.setTextureRect(sf::IntRect{16, 0, 16, 16});
-    sf::Sprite sprite20(textBoxSkin);
-    sprite20.setTextureRect(sf::IntRect{32, 0, 16, 16});
-    sf::Sprite sprite01(textBoxSkin);
-    sprite01.setTextureRect(sf::IntRect{0, 16, 16, 16});
-    sf::Sprite sprite21(textBoxSkin);
-    sprite21.setTextureRect(sf::IntRect{32, 16, 16, 16});
-    sf::Sprite sprite02(textBoxSkin);
-    sprite02.setTextureRect(sf::IntRect{0, 32, 16, 16});
-    sf::Sprite sprite12(textBoxSkin);
-    sprite12.setTextureRect(sf::IntRect{16, 32, 16, 16});
-    sf::Sprite sprite22(textBoxSkin);
-    sprite22.setTextureRect(sf::IntRect{32, 32, 16, 16});
+    // The skin is a 3x3 grid of 16x16 pieces, somewhere in an atlas page
+    auto& skin = storage.get<engine::spritesystem::AtlasRegion>("text-skin-1");
+    sf::Texture& textBoxSkin = storage.get<sf::Texture>(skin.page);
+    auto piece = [&](int column, int row) {
+        return sf::Sprite(textBoxSkin, sf::IntRect{
+            skin.rect.left + 16 * column,
+            skin.rect.top + 16 * row,
+            16,
+            16
+        });
+    };
+
+    sf::Sprite sprite00 = piece(0, 0);
+    sf::Sprite sprite10 = piece(1, 0);
+    sf::Sprite sprite20 = piece(2, 0);
+    sf::Sprite sprite01 = piece(0, 1);
+    sf::Sprite sprite21 = piece(2, 1);
+    sf::Sprite sprite02 = piece(0, 2);
+    sf::Sprite sprite12 = piece(1, 2);
+    sf::Sprite sprite22 = piece(2, 2);
 
     return {{
         {sprite00, sprite01, sprite02},
@@ -289,7 +292,7 @@ void renderTextBoxes(
     Camera& camera = storage.get<Camera>("camera");
     updateTextBoxVariables(camera);
 
-    manager.forEachEntity<TextBox>(
+    manager.query<TextBox>().forEach(
         [&](
             Entity entity,
             TextBox& textBox
@@ -299,7 +302,7 @@ void renderTextBoxes(
         }
     );
 
-    manager.forEachEntity<BattleActionSelection>(
+    manager.query<BattleActionSelection>().forEach(
         [&](
             Entity entity,
             BattleActionSelection& selection
@@ -332,7 +335,7 @@ void renderTextBoxes(
         }
     );
 
-    manager.forEachEntity<BattleMoveSelection>(
+    manager.query<BattleMoveSelection>().forEach(
         [&](
             Entity entity,
             BattleMoveSelection& selection
@@ -1,6 +1,7 @@
 #include "render.hpp"
 
 #include <SFML/Graphics.hpp>
+#include "battle/PokemonSpriteCache.hpp"
 #include "battle/render-battle.hpp"
 #include "components/DrawableVector.hpp"
 #include "engine/entity-system/include.hpp"
@@ -10,6 +11,7 @@
 #include "overworld/render-map.hpp"
 #include "MapLayer.hpp"
 #include "render-textboxes.hpp"
+#include "ResourceIds.hpp"
 
 using engine::entitysystem::Entity;
 using engine::utils::Menu;
@@ -25,7 +27,7 @@ void renderMenus(
     size_t windowWidth = windowSize.x;
     size_t windowHeight = windowSize.y;
 
-    manager.forEachEntity<Menu>(
+    manager.query<Menu>().forEach(
         [&](Entity entity, Menu& menu) {
             size_t focusedIndex = menu.getFocusedOption();
             size_t numOptions = menu.size();
@@ -68,7 +70,7 @@ void renderDrawableVectors(
     engine::entitysystem::ComponentManager& manager,
     engine::resourcesystem::ResourceStorage& storage
 ) {
-    manager.forEachEntity<DrawableVector>(
+    manager.query<DrawableVector>().forEach(
         [&](
             Entity entity,
             DrawableVector& vector
@@ -80,15 +82,59 @@ void renderDrawableVectors(
     );
 }
 
+void renderLoadingScreen(
+    sf::RenderWindow& window,
+    const engine::resourcesystem::LoadingProgress& progress
+) {
+    sf::Vector2u windowSize = window.getSize();
+    float width = windowSize.x / 2;
+    float height = windowSize.y / 20;
+    float x = (windowSize.x - width) / 2;
+    float y = (windowSize.y - height) / 2;
+    float ratio = progress.total > 0 ? float(progress.completed) / progress.total : 0;
+
+    sf::RectangleShape frame({width, height});
+    frame.setPosition(x, y);
+    frame.setFillColor(sf::Color::Transparent);
+    frame.setOutlineColor(sf::Color::White);
+    frame.setOutlineThickness(2);
+    window.draw(frame);
+
+    sf::RectangleShape bar({width * ratio, height});
+    bar.setPosition(x, y);
+    bar.setFillColor(sf::Color::Green);
+    window.draw(bar);
+}
+
+RenderHandles resolveRenderHandles(engine::resourcesystem::ResourceStorage& storage) {
+    using engine::resourcesystem::LoadingProgress;
+
+    RenderHandles handles;
+    handles.loadingProgress = storage.handle<LoadingProgress>(ResourceIds::LOADING_PROGRESS);
+    handles.pokemonSprites = storage.handle<PokemonSpriteCache>(ResourceIds::POKEMON_SPRITES);
+    return handles;
+}
+
 void render(
     sf::RenderWindow& window,
     engine::entitysystem::ComponentManager& manager,
-    engine::resourcesystem::ResourceStorage& storage
+    engine::resourcesystem::ResourceStorage& storage,
+    const RenderHandles& handles
 ) {
+    auto& progress = storage.get(handles.loadingProgress);
+
+    // Nothing else can be drawn until all resources are loaded
+    if (!progress.finished()) {
+        renderLoadingScreen(window, progress);
+        return;
+    }
+
+    storage.get(handles.pokemonSprites).nextFrame();
+
     renderMapLayer(MapLayer::Terrain, window, manager, storage);
     renderMapLayer(MapLayer::Objects, window, manager, storage);
     renderMenus(window, manager, storage);
-    renderBattle(window, manager, storage);
+    renderBattle(window, manager, storage, handles.pokemonSprites);
     renderLoopingAnimations(window, manager);
     renderMapLayer(MapLayer::Foreground, window, manager, storage);
     renderTextBoxes(window, manager, storage);
@@ -1,18 +1,24 @@
 #include "states/BattleState.hpp"
 
-#include "battle/data/Pokemon.hpp"
+#include "battle/helpers/battle-setup.hpp"
 #include "battle/text-providers/EventTextProvider.hpp"
-#include "components/battle/Battle.hpp"
 #include "core-functions.hpp"
 #include "CoreStructures.hpp"
 #include "engine/entity-system/include.hpp"
 
+#include "engine/utils/debug/xtrace.hpp"
+
 BattleState::BattleState(CoreStructures& gameData)
  : gameData(gameData),
-   battleEntity(createEntity(gameData)),
    textProvider(new EventTextProvider()) { }
 
 void BattleState::onEnterImpl() {
+    // The battle entity is destroyed by the cleanup in onExitImpl(), so its
+    // handle must be renewed
+    if (!gameData.componentManager->isValid(battleEntity)) {
+        battleEntity = createEntity(gameData);
+    }
+
     battleController = BattleController(battleEntity, *textProvider, gameData);
     interactiveLayer = InteractiveLayer(battleEntity, battleController, gameData);
     battleSetup = BattleSetup(battleEntity, battleController, interactiveLayer, gameData);
@@ -22,8 +28,9 @@ void BattleState::onEnterImpl() {
 void BattleState::onExitImpl() {
     interactiveLayer.abort();
     music("bgm-wild-battle", gameData).stop();
-    deleteEntity(battleEntity, gameData);
-    gameData.componentManager->cleanup<Battle, Pokemon>();
+
+    size_t reclaimedBytes = teardownBattle(battleEntity, gameData);
+    ECHO("[BATTLE] Cleanup reclaimed " + std::to_string(reclaimedBytes) + " bytes");
 }
 
 void BattleState::executeImpl() {
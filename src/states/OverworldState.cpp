@@ -18,6 +18,7 @@
 #include "overworld/on-tile-step.hpp"
 #include "overworld/overworld-utils.hpp"
 #include "overworld/process-interaction.hpp"
+#include "ResourceIds.hpp"
 
 #include "engine/utils/debug/xtrace.hpp"
 
@@ -40,6 +41,9 @@ OverworldState::OverworldState(CoreStructures& gameData)
  : gameData(gameData),
    player(createEntity(gameData)),
    map(createEntity(gameData)) {
+    gameData.componentManager->group<Velocity, Position>();
+    gameData.componentManager->group<LoopingAnimationData, AnimationPlaybackData>();
+
     addComponent(player, Direction::South, gameData);
     addComponent(player, Position{5, 5}, gameData);
     addComponent(player, Velocity{0, 0}, gameData);
@@ -48,7 +52,7 @@ OverworldState::OverworldState(CoreStructures& gameData)
     updatePlayerAnimation(player, gameData);
     removeComponent<AnimationPlaybackData>(player, gameData);
 
-    gameData.resourceStorage->store("player-event-queue", EventQueue());
+    gameData.resourceStorage->store(ResourceIds::PLAYER_EVENT_QUEUE, EventQueue());
 
     lua::internal::setCoreStructures(gameData);
     lua::internal::setMap(map);
@@ -133,13 +137,14 @@ void OverworldState::executeImpl() {
         onNearTile();
     }
 
-    resource<EventQueue>("player-event-queue", gameData).tick();
+    resource<EventQueue>(ResourceIds::PLAYER_EVENT_QUEUE, gameData).tick();
     processMovingEntities();
     adjustPlayerSpritePosition();
     adjustCameraPosition();
 
     playAnimations<LoopingAnimationData>(
         *gameData.componentManager,
+        animationCommands,
         *gameData.timeSinceLastFrame
     );
     pressingDirectionKey = false;
@@ -195,10 +200,10 @@ void OverworldState::processMovingEntities() {
     ComponentManager& manager = *gameData.componentManager;
     double timeSinceLastFrame = *gameData.timeSinceLastFrame;
 
-    manager.forEachEntity<Velocity, Position>(
+    manager.parallelForEachEntity<const Velocity, Position>(
         [&](
             Entity entity,
-            Velocity& velocity,
+            const Velocity& velocity,
             Position& position
         ) {
             position.x += velocity.x * timeSinceLastFrame;
@@ -0,0 +1,44 @@
+#ifndef BENCHMARK_UTILS_HPP
+#define BENCHMARK_UTILS_HPP
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "engine/utils/timing/Profiler.hpp"
+
+// Prevents the compiler from discarding the results of benchmarked code
+inline volatile size_t benchmarkSink;
+
+// Runs a function once, returning the elapsed time in microseconds
+template<typename Functor>
+intmax_t measure(Functor fn) {
+    engine::utils::Profiler profiler;
+    profiler.start();
+    fn();
+    profiler.finish();
+    return profiler.measureAsMicroseconds();
+}
+
+inline void printHeader(const std::string& name) {
+    std::cout << "[" << name << "]" << std::endl;
+}
+
+inline void printMeasurement(const std::string& label, intmax_t microseconds) {
+    std::cout << "  " << std::left << std::setw(48) << label;
+    std::cout << std::right << std::setw(12) << microseconds << " us" << std::endl;
+}
+
+// Prints how many megabytes per second were processed
+inline void printThroughput(const std::string& label, size_t bytes, intmax_t microseconds) {
+    std::cout << "  " << std::left << std::setw(48) << label;
+    std::cout << std::right << std::setw(12) << std::fixed << std::setprecision(1)
+              << bytes / double(microseconds > 0 ? microseconds : 1) << " MB/s" << std::endl;
+}
+
+inline void printCount(const std::string& label, size_t count) {
+    std::cout << "  " << std::left << std::setw(48) << label;
+    std::cout << std::right << std::setw(12) << count << std::endl;
+}
+
+#endif
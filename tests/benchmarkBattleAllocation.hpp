@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "battle/BattleController.hpp"
+#include "battle/data/EncounterData.hpp"
+#include "battle/data/Move.hpp"
+#include "battle/data/PokemonSpeciesData.hpp"
+#include "battle/helpers/battle-setup.hpp"
+#include "battle/PokemonSpriteCache.hpp"
+#include "battle/text-providers/NullTextProvider.hpp"
+#include "benchmark-utils.hpp"
+#include "core-functions.hpp"
+#include "CoreStructures.hpp"
+#include "engine/entity-system/include.hpp"
+#include "engine/resource-system/include.hpp"
+#include "engine/utils/timing/count-allocations.hpp"
+#include "ResourceIds.hpp"
+
+namespace {
+    using engine::entitysystem::ComponentManager;
+    using engine::entitysystem::Entity;
+    using engine::resourcesystem::ResourceStorage;
+
+    // The species, moves and encounters used by setupWildEncounter()
+    void storeBattleResources(ResourceStorage& storage) {
+        for (std::string name : {"Rattata", "Pidgey"}) {
+            PokemonSpeciesData species{};
+            species.displayName = name;
+            species.types = {"NORMAL", "FLYING"};
+            species.baseStats = {30, 56, 35, 25, 35, 72};
+            species.maleRatio = "50";
+            species.growthRate = "Medium";
+            species.abilities = {"RUNAWAY", "GUTS"};
+            species.hiddenAbilities = {"HUSTLE"};
+            species.moves = {{1, "TACKLE"}, {1, "TAILWHIP"}, {4, "QUICKATTACK"}, {7, "FOCUSENERGY"}};
+            species.eggMoves = {"BITE", "COUNTER", "FLAMEWHEEL"};
+            species.eggGroups = {"Field"};
+            species.color = "Purple";
+            species.habitat = "Grassland";
+            species.kind = "Mouse";
+            species.pokedexDescription = "Will chew on anything with its fangs. If you see one, "
+                "you can be certain that 40 more live in the area.";
+            species.evolutions = {{"Raticate", JsonValue()}};
+            storage.store("pokemon-" + name, std::move(species));
+        }
+
+        for (std::string id : {"TACKLE", "TAILWHIP", "QUICKATTACK", "FOCUSENERGY"}) {
+            Move move{};
+            move.id = id;
+            move.displayName = id;
+            move.type = "NORMAL";
+            move.pp = 30;
+            storage.store("move-" + id, std::move(move));
+        }
+
+        MapEncounterData encounters;
+        encounters.encounterData["land"] = {{"Pidgey", 2, 2, 100}};
+        storage.store("encounters-map-basic", std::move(encounters));
+        // Sprites are only decoded when drawn, which never happens here
+        storage.store(ResourceIds::POKEMON_SPRITES, PokemonSpriteCache(
+            "resources/sprites/pokemon/back/",
+            "resources/sprites/pokemon/front/",
+            4 * 1024 * 1024,
+            64
+        ));
+    }
+
+    // Sets a wild battle up, starts it and tears it down as BattleState does
+    void runBattle(CoreStructures& gameData, TextProvider& textProvider) {
+        Entity battleEntity = createEntity(gameData);
+        setupWildEncounter("map-basic", battleEntity, gameData);
+        BattleController controller(battleEntity, textProvider, gameData);
+        controller.startBattle();
+        controller.abort();
+        teardownBattle(battleEntity, gameData);
+    }
+}
+
+void benchmarkBattleAllocation() {
+    constexpr size_t numBattles = 1000;
+
+    ResourceStorage storage;
+    storeBattleResources(storage);
+    NullTextProvider textProvider;
+    ComponentManager manager;
+    CoreStructures gameData{&manager, nullptr, &storage, nullptr, nullptr};
+
+    printHeader("Battle setup and teardown: " + std::to_string(numBattles) + " battles");
+
+    // The first battle creates the storages themselves
+    runBattle(gameData, textProvider);
+
+    // Counted by the allocation functions of count-allocations.cpp. The
+    // battles run on this thread.
+    size_t allocationsBefore = engine::utils::allocationCount();
+    intmax_t elapsed = measure([&] {
+        for (size_t i = 0; i < numBattles; ++i) {
+            runBattle(gameData, textProvider);
+        }
+    });
+
+    printCount("allocations per battle", (engine::utils::allocationCount() - allocationsBefore) / numBattles);
+    printMeasurement("time", elapsed);
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "benchmark-utils.hpp"
+#include "engine/entity-system/include.hpp"
+
+using engine::entitysystem::ComponentManager;
+using engine::entitysystem::Entity;
+using engine::entitysystem::SparseSet;
+
+namespace {
+    struct BenchmarkPosition {
+        float x;
+        float y;
+    };
+
+    struct BenchmarkVelocity {
+        float x;
+        float y;
+    };
+
+    template<int Id>
+    struct Tagged : BenchmarkPosition {};
+
+    std::vector<Entity> shuffledEntities(size_t count) {
+        std::vector<Entity> entities;
+        entities.reserve(count);
+
+        for (Entity::Index index = 0; index < count; ++index) {
+            entities.push_back({index, 1});
+        }
+
+        std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+        return entities;
+    }
+
+    void benchmarkMapStorage(size_t count, const std::vector<Entity>& lookups) {
+        std::unordered_map<Entity, BenchmarkPosition> storage;
+
+        printMeasurement("map: insertion", measure([&] {
+            for (Entity::Index index = 0; index < count; ++index) {
+                storage.insert({{index, 1}, {1, 2}});
+            }
+        }));
+
+        printMeasurement("map: iteration", measure([&] {
+            float sum = 0;
+            for (auto& [entity, position] : storage) {
+                sum += position.x + position.y;
+            }
+            benchmarkSink = sum;
+        }));
+
+        printMeasurement("map: random access", measure([&] {
+            float sum = 0;
+            for (Entity entity : lookups) {
+                sum += storage.at(entity).x;
+            }
+            benchmarkSink = sum;
+        }));
+    }
+
+    void benchmarkSparseSetStorage(size_t count, const std::vector<Entity>& lookups) {
+        SparseSet<BenchmarkPosition> storage;
+
+        printMeasurement("sparse set: insertion", measure([&] {
+            for (Entity::Index index = 0; index < count; ++index) {
+                storage.emplace({index, 1}, BenchmarkPosition{1, 2});
+            }
+        }));
+
+        printMeasurement("sparse set: iteration", measure([&] {
+            float sum = 0;
+            for (size_t i = 0; i < storage.size(); ++i) {
+                BenchmarkPosition& position = storage.dataAt(i);
+                sum += position.x + position.y;
+            }
+            benchmarkSink = sum;
+        }));
+
+        printMeasurement("sparse set: random access", measure([&] {
+            float sum = 0;
+            for (Entity entity : lookups) {
+                sum += storage.get(entity).x;
+            }
+            benchmarkSink = sum;
+        }));
+    }
+
+    template<typename TPosition, typename TVelocity, bool Cached = false>
+    void benchmarkQuery(const std::string& label, ComponentManager& manager, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            Entity entity = manager.createEntity();
+            manager.addComponent(entity, TPosition{});
+
+            if (i % 2 == 0) {
+                manager.addComponent(entity, TVelocity{});
+            }
+        }
+
+        auto update = [&](Entity, TPosition& position, const TVelocity& velocity) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        };
+
+        if constexpr (Cached) {
+            // Builds the cache and saves the dense indexes outside of the
+            // measurement
+            manager.query<TPosition, const TVelocity>().forEach(update);
+        }
+
+        printMeasurement(label, measure([&] {
+            if constexpr (Cached) {
+                manager.query<TPosition, const TVelocity>().forEach(update);
+            } else {
+                manager.forEachEntity<TPosition, const TVelocity>(update);
+            }
+        }));
+
+        manager.clearAll<TPosition, TVelocity>();
+    }
+
+    void benchmarkMultiComponentQuery(size_t count) {
+        ComponentManager manager;
+        manager.group<Tagged<1>, Tagged<2>>();
+        benchmarkQuery<Tagged<0>, BenchmarkVelocity>("query (lookups)", manager, count);
+        benchmarkQuery<Tagged<1>, Tagged<2>>("query (group)", manager, count);
+        benchmarkQuery<Tagged<3>, Tagged<4>, true>("query (cached)", manager, count);
+    }
+}
+
+void benchmarkComponentStorage() {
+    for (size_t count : {1000, 100000, 1000000}) {
+        printHeader("Component storage: " + std::to_string(count) + " entities");
+        std::vector<Entity> lookups = shuffledEntities(count);
+        benchmarkMapStorage(count, lookups);
+        benchmarkSparseSetStorage(count, lookups);
+        benchmarkMultiComponentQuery(count);
+    }
+}
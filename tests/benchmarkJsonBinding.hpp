@@ -0,0 +1,121 @@
+#include <string>
+#include <string_view>
+#include <tuple>
+#include "battle/data/Move.hpp"
+#include "benchmark-utils.hpp"
+#include "engine/resource-system/json/include.hpp"
+
+template<>
+struct JsonBinding<Move> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("display-name", &Move::displayName),
+        jsonField("type", &Move::type),
+        jsonField("kind", &Move::kind),
+        jsonField("function-code", &Move::functionCode),
+        jsonField("function-parameter", &Move::functionParameter),
+        jsonField("power", &Move::power),
+        jsonField("accuracy", &Move::accuracy),
+        jsonField("pp", &Move::pp),
+        jsonField("effect-rate", &Move::effectRate),
+        jsonField("target-type", &Move::targetType),
+        jsonField("priority", &Move::priority),
+        jsonField("flags", &Move::flags),
+        jsonField("description", &Move::description)
+    );
+};
+
+namespace {
+    // Move records shaped like the ones of moves.json
+    std::string syntheticMovesJSON(size_t numMoves) {
+        std::string document = "{\n";
+
+        for (size_t i = 0; i < numMoves; ++i) {
+            document += (i > 0 ? ",\n" : "");
+            document += "    \"MOVE" + std::to_string(i) + "\": {\n"
+                "        \"display-name\": \"Move " + std::to_string(i) + "\",\n"
+                "        \"function-code\": 0,\n"
+                "        \"function-parameter\": 0,\n"
+                "        \"power\": " + std::to_string(i % 150) + ",\n"
+                "        \"type\": \"NORMAL\",\n"
+                "        \"kind\": \"Physical\",\n"
+                "        \"accuracy\": 100,\n"
+                "        \"pp\": 35,\n"
+                "        \"effect-rate\": 0,\n"
+                "        \"target-type\": \"SingleNonUser\",\n"
+                "        \"priority\": 0,\n"
+                "        \"flags\": \"abef\",\n"
+                "        \"description\": \"A physical attack in which the user charges and slams into the target.\"\n"
+                "    }";
+        }
+
+        return document + "\n}\n";
+    }
+
+    // Maps the fields by hand, looking each key up in the document
+    std::vector<std::pair<std::string, Move>> readMovesByHand(const JsonValue& data) {
+        std::vector<std::pair<std::string, Move>> moves;
+
+        for (const auto& [id, moveData] : data.asIterableMap()) {
+            Move move;
+            move.id = id;
+            move.displayName = moveData["display-name"].asString();
+            move.type = moveData["type"].asString();
+            move.kind = moveData["kind"].asString();
+            move.functionCode = moveData["function-code"].asInt();
+            move.functionParameter = moveData["function-parameter"].asInt();
+            move.power = moveData["power"].asInt();
+            move.accuracy = moveData["accuracy"].asInt();
+            move.pp = moveData["pp"].asInt();
+            move.effectRate = moveData["effect-rate"].asInt();
+            move.targetType = moveData["target-type"].asString();
+            move.priority = moveData["priority"].asInt();
+            move.flags = moveData["flags"].asString();
+            move.description = moveData["description"].asString();
+            moves.emplace_back(id, std::move(move));
+        }
+
+        return moves;
+    }
+}
+
+void benchmarkJsonBinding() {
+    constexpr size_t numMoves = 100000;
+
+    printHeader("JSON binding");
+
+    std::string document = syntheticMovesJSON(numMoves);
+    JsonValue parsed = parseJSON(std::string_view(document));
+    size_t power = 0;
+
+    printMeasurement("From a document, fields by hand", measure([&] {
+        for (const auto& [id, move] : readMovesByHand(parsed)) {
+            power += move.power;
+        }
+    }));
+
+    printMeasurement("From a document, bindJSON", measure([&] {
+        std::vector<std::pair<std::string, Move>> moves;
+        bindJSON(parsed, moves);
+
+        for (const auto& [id, move] : moves) {
+            power += move.power;
+        }
+    }));
+
+    printThroughput("parseJSON, fields by hand", document.size(), measure([&] {
+        for (const auto& [id, move] : readMovesByHand(parseJSON(std::string_view(document)))) {
+            power += move.power;
+        }
+    }));
+
+    printThroughput("bindJSON(std::string_view)", document.size(), measure([&] {
+        std::vector<std::pair<std::string, Move>> moves;
+        bindJSON(std::string_view(document), moves);
+
+        for (const auto& [id, move] : moves) {
+            power += move.power;
+        }
+    }));
+
+    benchmarkSink = power;
+}
@@ -0,0 +1,188 @@
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include "benchmark-utils.hpp"
+#include "engine/resource-system/json/include.hpp"
+#include "ResourceFiles.hpp"
+
+namespace {
+    // The scanner that read streams one character at a time, kept as the
+    // baseline
+    class StreamJsonScanner {
+     public:
+        struct StreamToken {
+            TokenKind kind;
+            std::string text;
+        };
+
+        explicit StreamJsonScanner(std::istream& stream) : stream(stream) { }
+
+        StreamToken scan() {
+            char ch = currentChar == 0 ? stream.get() : currentChar;
+            currentChar = 0;
+            constexpr auto eof = std::char_traits<char>::eof();
+
+            switch (ch) {
+                case eof:
+                    return {TokenKind::EndOfFile, ""};
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                    return scan();
+                case '"': {
+                    std::stringstream ss;
+
+                    for (ch = stream.get(); ch != '"'; ch = stream.get()) {
+                        ss << ch;
+                    }
+
+                    return {TokenKind::StringLiteral, ss.str()};
+                }
+                case 't':
+                    return scanExactly("true", TokenKind::BooleanLiteral);
+                case 'f':
+                    return scanExactly("false", TokenKind::BooleanLiteral);
+                case 'n':
+                    return scanExactly("null", TokenKind::NullLiteral);
+                case '[':
+                    return {TokenKind::OpenBracket, "["};
+                case ']':
+                    return {TokenKind::CloseBracket, "]"};
+                case '{':
+                    return {TokenKind::OpenBrace, "{"};
+                case '}':
+                    return {TokenKind::CloseBrace, "}"};
+                case ':':
+                    return {TokenKind::Colon, ":"};
+                case ',':
+                    return {TokenKind::Comma, ","};
+                default: {
+                    std::stringstream ss;
+
+                    do {
+                        ss << ch;
+                        ch = stream.get();
+                    } while (ch >= '0' && ch <= '9');
+
+                    currentChar = ch;
+                    return {TokenKind::NumberLiteral, ss.str()};
+                }
+            }
+        }
+
+     private:
+        std::istream& stream;
+        char currentChar = 0;
+
+        StreamToken scanExactly(const std::string& content, TokenKind tokenKind) {
+            for (size_t i = 1; i < content.size(); ++i) {
+                stream.get();
+            }
+
+            return {tokenKind, content};
+        }
+    };
+
+    struct ValueCounter : JsonHandler {
+        size_t count = 0;
+
+        void onString(std::string_view) { ++count; }
+        void onNumber(int64_t) { ++count; }
+        void onDouble(double) { ++count; }
+    };
+
+    // Species records shaped like the ones of pokemon.json. The stream
+    // scanner doesn't know escaped quotes, so there are none
+    std::string syntheticSpeciesJSON(size_t size) {
+        std::string document = "{\n";
+
+        for (size_t i = 0; document.size() < size; ++i) {
+            std::string name = "Species" + std::to_string(i);
+            document += (i > 0 ? ",\n" : "");
+            document += "    \"" + name + "\": {\n"
+                "        \"display-name\": \"" + name + "\",\n"
+                "        \"national-number\": " + std::to_string(i) + ",\n"
+                "        \"types\": [\"Grass\", \"Poison\"],\n"
+                "        \"base-stats\": [45, 49, 49, 65, 65, 45],\n"
+                "        \"male-ratio\": \"87.5\",\n"
+                "        \"growth-rate\": \"Parabolic\",\n"
+                "        \"base-exp\": 64,\n"
+                "        \"effort-points\": [0, 0, 0, 1, 0, 0],\n"
+                "        \"height\": 0.7,\n"
+                "        \"weight\": 6.9,\n"
+                "        \"capture-rate\": 45,\n"
+                "        \"abilities\": [\"Overgrow\"],\n"
+                "        \"moves\": [{ \"level\": 1, \"move\": \"Tackle\" }, { \"level\": 7, \"move\": \"Leech Seed\" }],\n"
+                "        \"pokedex-description\": \"A strange seed was planted on its back at birth.\\n"
+                "The plant sprouts and grows with this Pok\\u00E9mon.\"\n"
+                "    }";
+        }
+
+        return document + "\n}\n";
+    }
+
+    void benchmarkScanners(const std::string& name, const std::string& document, size_t repetitions) {
+        size_t bytes = document.size() * repetitions;
+        size_t numTokens = 0;
+
+        // The stream is filled beforehand, as a file would be by its buffer
+        intmax_t streamTime = 0;
+
+        for (size_t i = 0; i < repetitions; ++i) {
+            std::istringstream stream(document);
+            streamTime += measure([&] {
+                StreamJsonScanner scanner(stream);
+                while (scanner.scan().kind != TokenKind::EndOfFile) {
+                    ++numTokens;
+                }
+            });
+        }
+
+        printThroughput(name + ": stream scanner", bytes, streamTime);
+
+        printThroughput(name + ": buffer scanner", bytes, measure([&] {
+            for (size_t i = 0; i < repetitions; ++i) {
+                JsonScanner scanner(document);
+                while (scanner.scan().kind != TokenKind::EndOfFile) {
+                    ++numTokens;
+                }
+            }
+        }));
+
+        printThroughput(name + ": readJSON, counting values", bytes, measure([&] {
+            for (size_t i = 0; i < repetitions; ++i) {
+                ValueCounter counter;
+                readJSON(std::string_view(document), counter);
+                numTokens += counter.count;
+            }
+        }));
+
+        printThroughput(name + ": parseJSON(std::string_view)", bytes, measure([&] {
+            for (size_t i = 0; i < repetitions; ++i) {
+                JsonValue value = parseJSON(std::string_view(document));
+                numTokens += value.is<std::unordered_map<std::string, JsonValue>>();
+            }
+        }));
+
+        benchmarkSink = numTokens;
+    }
+}
+
+void benchmarkJsonScanner() {
+    constexpr size_t mapRepetitions = 200;
+    constexpr size_t speciesSize = 50 * 1024 * 1024;
+
+    printHeader("JSON scanning");
+
+    std::ifstream mapFile(ResourceFiles::MAPS);
+
+    if (mapFile) {
+        std::string maps(std::istreambuf_iterator<char>(mapFile), {});
+        benchmarkScanners("maps.json x" + std::to_string(mapRepetitions), maps, mapRepetitions);
+    }
+
+    benchmarkScanners("species, 50 MB", syntheticSpeciesJSON(speciesSize), 1);
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include "benchmark-utils.hpp"
+#include "engine/entity-system/include.hpp"
+#include "engine/utils/threading/ThreadPool.hpp"
+
+namespace {
+    struct ParallelPosition {
+        float x;
+        float y;
+    };
+
+    struct ParallelVelocity {
+        float x;
+        float y;
+    };
+
+    void integrate(const ParallelVelocity& velocity, ParallelPosition& position) {
+        float speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+        float angle = std::atan2(velocity.y, velocity.x);
+        position.x += speed * std::cos(angle) * 0.016f;
+        position.y += speed * std::sin(angle) * 0.016f;
+    }
+}
+
+void benchmarkParallelIteration() {
+    using engine::entitysystem::ComponentManager;
+    using engine::entitysystem::Entity;
+    constexpr size_t numEntities = 500000;
+    constexpr size_t grainSize = 4096;
+
+    ComponentManager manager;
+    manager.group<ParallelVelocity, ParallelPosition>();
+
+    for (size_t i = 0; i < numEntities; ++i) {
+        Entity entity = manager.createEntity();
+        manager.addComponent(entity, ParallelPosition{0, 0});
+        manager.addComponent(entity, ParallelVelocity{1, static_cast<float>(i % 7)});
+    }
+
+    printHeader("Parallel iteration: " + std::to_string(numEntities) + " entities");
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t numThreads = 1;; numThreads = std::min(numThreads * 2, maxThreads)) {
+        engine::utils::ThreadPool pool(numThreads);
+        manager.setThreadPool(&pool);
+
+        printMeasurement(std::to_string(numThreads) + " thread(s)", measure([&] {
+            manager.parallelForEachEntity<const ParallelVelocity, ParallelPosition>(
+                [](Entity, const ParallelVelocity& velocity, ParallelPosition& position) {
+                    integrate(velocity, position);
+                },
+                grainSize
+            );
+        }));
+
+        if (numThreads == maxThreads) {
+            break;
+        }
+    }
+
+    manager.setThreadPool(nullptr);
+    manager.clearAll<ParallelPosition, ParallelVelocity>();
+}
@@ -0,0 +1,66 @@
+#include <string>
+#include <vector>
+#include "benchmark-utils.hpp"
+#include "engine/resource-system/include.hpp"
+
+namespace {
+    struct LookupTexture {
+        int width;
+        int height;
+    };
+}
+
+void benchmarkResourceLookup() {
+    using engine::resourcesystem::ResourceHandle;
+    using engine::resourcesystem::ResourceId;
+    using engine::resourcesystem::ResourceStorage;
+    constexpr size_t numSpecies = 800;
+    constexpr size_t numLookups = 1000000;
+    constexpr ResourceId literalId = "pokemon-back-species400";
+
+    ResourceStorage storage;
+    std::vector<std::string> species;
+
+    for (size_t i = 0; i < numSpecies; ++i) {
+        species.push_back("species" + std::to_string(i));
+        storage.store("pokemon-back-" + species.back(), LookupTexture{64, 64});
+    }
+
+    const std::string& current = species[numSpecies / 2];
+    std::string key = "pokemon-back-" + current;
+    ResourceHandle<LookupTexture> handle = storage.handle<LookupTexture>(key);
+
+    printHeader("Resource lookups: " + std::to_string(numLookups) + " lookups");
+
+    printMeasurement("string: built every lookup", measure([&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < numLookups; ++i) {
+            sum += storage.get<LookupTexture>("pokemon-back-" + current).width;
+        }
+        benchmarkSink = sum;
+    }));
+
+    printMeasurement("string: prebuilt", measure([&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < numLookups; ++i) {
+            sum += storage.get<LookupTexture>(key).width;
+        }
+        benchmarkSink = sum;
+    }));
+
+    printMeasurement("compile-time hashed literal", measure([&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < numLookups; ++i) {
+            sum += storage.get<LookupTexture>(literalId).width;
+        }
+        benchmarkSink = sum;
+    }));
+
+    printMeasurement("handle", measure([&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < numLookups; ++i) {
+            sum += storage.get(handle).width;
+        }
+        benchmarkSink = sum;
+    }));
+}
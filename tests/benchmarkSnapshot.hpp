@@ -0,0 +1,95 @@
+#include <string>
+#include <vector>
+#include "battle/data/Pokemon.hpp"
+#include "benchmark-utils.hpp"
+#include "components/Position.hpp"
+#include "components/battle/Battle.hpp"
+#include "components/battle/VolatileData.hpp"
+#include "engine/entity-system/include.hpp"
+
+namespace {
+    // Stands for Tile, whose sprites need SFML
+    struct SnapshotTile {
+        std::vector<int> layers;
+    };
+
+    Pokemon snapshotPokemon(int level) {
+        Pokemon pokemon{};
+        pokemon.species = "BULBASAUR";
+        pokemon.displayName = "Bulbasaur";
+        pokemon.moves = {"TACKLE", "GROWL", "VINEWHIP", "LEECHSEED"};
+        pokemon.pp = {35, 40, 25, 10};
+        pokemon.ppUps = {0, 0, 0, 0};
+        pokemon.level = level;
+        pokemon.stats = {45, 49, 49, 65, 65, 45};
+        pokemon.currentHP = 45;
+        return pokemon;
+    }
+}
+
+void benchmarkSnapshot() {
+    using engine::entitysystem::ComponentManager;
+    using engine::entitysystem::Entity;
+    constexpr size_t mapSize = 128;
+    constexpr size_t teamSize = 6;
+    constexpr size_t numRollbacks = 1000;
+    constexpr intmax_t frameMicroseconds = 1000000 / 60;
+
+    ComponentManager manager;
+
+    // The overworld stays loaded during battles
+    for (size_t i = 0; i < mapSize * mapSize; ++i) {
+        Entity entity = manager.createEntity();
+        manager.addComponent(entity, Position{float(i % mapSize), float(i / mapSize)});
+        manager.addComponent(entity, SnapshotTile{{0, 1}});
+    }
+
+    Battle battle;
+
+    for (size_t i = 0; i < 2 * teamSize; ++i) {
+        Entity entity = manager.createEntity();
+        manager.addComponent(entity, snapshotPokemon(5 + i));
+        manager.addComponent(entity, VolatileData{});
+        (i < teamSize ? battle.playerTeam : battle.opponentTeam).push_back(entity);
+    }
+
+    Entity battleEntity = manager.createEntity();
+    manager.addComponent(battleEntity, std::move(battle));
+
+    printHeader("Snapshots: " + std::to_string(mapSize * mapSize) + " tiles, 2 teams of "
+        + std::to_string(teamSize) + " Pokemon");
+
+    ComponentManager::Snapshot snapshot;
+
+    printMeasurement("snapshot", measure([&] {
+        snapshot = manager.snapshot();
+    }));
+
+    // A simulated turn: one move used, one Pokemon damaged and debuffed
+    auto simulateTurn = [&] {
+        auto& battle = manager.getData<Battle>(battleEntity);
+        Entity attacker = battle.playerTeam[0];
+        Entity target = battle.opponentTeam[0];
+        battle.usedMoves.push_back({});
+        manager.getData<Pokemon>(attacker).pp[0] -= 1;
+        manager.getData<Pokemon>(target).currentHP -= 7;
+        manager.getData<VolatileData>(target).statStages[0] -= 1;
+    };
+
+    printMeasurement("turn + restore", measure([&] {
+        simulateTurn();
+        manager.restore(snapshot);
+    }));
+
+    intmax_t rollbacks = measure([&] {
+        for (size_t i = 0; i < numRollbacks; ++i) {
+            auto turnSnapshot = manager.snapshot();
+            simulateTurn();
+            manager.restore(turnSnapshot);
+        }
+    });
+
+    printMeasurement(std::to_string(numRollbacks) + " x (snapshot + turn + restore)", rollbacks);
+    printMeasurement("frame budget (60 FPS)", frameMicroseconds);
+    benchmarkSink = manager.getData<Battle>(battleEntity).usedMoves.size();
+}
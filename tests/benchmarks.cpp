@@ -0,0 +1,17 @@
+#include "benchmarkBattleAllocation.hpp"
+#include "benchmarkComponentStorage.hpp"
+#include "benchmarkJsonBinding.hpp"
+#include "benchmarkJsonScanner.hpp"
+#include "benchmarkParallelIteration.hpp"
+#include "benchmarkResourceLookup.hpp"
+#include "benchmarkSnapshot.hpp"
+
+int main(int, char**) {
+    benchmarkComponentStorage();
+    benchmarkParallelIteration();
+    benchmarkSnapshot();
+    benchmarkBattleAllocation();
+    benchmarkResourceLookup();
+    benchmarkJsonScanner();
+    benchmarkJsonBinding();
+}
@@ -0,0 +1,20 @@
+#ifndef ENGINE_TEST_UTILS_HPP
+#define ENGINE_TEST_UTILS_HPP
+
+/**
+ * \brief Checks if calling `fn` throws an exception of type E.
+ */
+template<typename E, typename Functor>
+bool throws(Functor fn) {
+    try {
+        fn();
+    } catch (const E&) {
+        return true;
+    } catch (...) {
+        return false;
+    }
+
+    return false;
+}
+
+#endif
@@ -0,0 +1,25 @@
+#include "testCommandBuffer.hpp"
+#include "testGroups.hpp"
+#include "testHotReloader.hpp"
+#include "testJsonBinding.hpp"
+#include "testJsonNumbers.hpp"
+#include "testJsonReader.hpp"
+#include "testJsonScanner.hpp"
+#include "testJsonValue.hpp"
+#include "testSnapshot.hpp"
+#include "testSparseSet.hpp"
+#include "testTimeline.hpp"
+
+int main(int, char**) {
+    testSparseSet();
+    testGroups();
+    testCommandBuffer();
+    testSnapshot();
+    testJsonScanner();
+    testJsonValue();
+    testJsonReader();
+    testJsonNumbers();
+    testJsonBinding();
+    testHotReloader();
+    testTimeline();
+}
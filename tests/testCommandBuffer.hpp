@@ -0,0 +1,112 @@
+#include <stdexcept>
+#include "engine/entity-system/CommandBuffer.hpp"
+#include "engine/entity-system/ComponentManager.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using engine::entitysystem::CommandBuffer;
+using engine::entitysystem::ComponentManager;
+using engine::entitysystem::Entity;
+using test::describe;
+using test::it;
+
+namespace {
+    struct Counter {
+        int value = 0;
+    };
+
+    struct Marked {};
+
+    size_t countEntities(ComponentManager& manager) {
+        size_t count = 0;
+        manager.forEachEntity<Counter>([&](Entity, Counter&) {
+            ++count;
+        });
+        return count;
+    }
+}
+
+void testCommandBuffer() {
+    describe("CommandBuffer", [&] {
+        it("defers structural changes until playback", [&] {
+            ComponentManager manager;
+            Entity entity = manager.createEntity();
+            manager.addComponent(entity, Counter{1});
+            CommandBuffer commands;
+
+            manager.forEachEntity<Counter>([&](Entity entity, Counter&) {
+                commands.removeComponent<Counter>(entity);
+                commands.addComponent<Marked>(entity);
+            });
+
+            expect(commands.empty()).toBe(false);
+            expect(manager.hasComponent<Counter>(entity)).toBe(true);
+
+            commands.playback(manager);
+
+            expect(commands.empty()).toBe(true);
+            expect(manager.hasComponent<Counter>(entity)).toBe(false);
+            expect(manager.hasComponent<Marked>(entity)).toBe(true);
+        });
+
+        it("creates the entities of its placeholders", [&] {
+            ComponentManager manager;
+            CommandBuffer commands;
+            Entity first = commands.createEntity();
+            Entity second = commands.createEntity();
+            commands.addComponent(second, Counter{2});
+            commands.addComponent(first, Counter{1});
+
+            expect(manager.isValid(first)).toBe(false);
+
+            commands.playback(manager);
+
+            int sum = 0;
+            manager.forEachEntity<Counter>([&](Entity, Counter& counter) {
+                sum += counter.value;
+            });
+
+            expect(countEntities(manager)).toBe(size_t(2));
+            expect(sum).toBe(3);
+        });
+
+        it("starts numbering placeholders again after playback", [&] {
+            ComponentManager manager;
+            CommandBuffer commands;
+            commands.createEntity();
+            commands.playback(manager);
+            Entity placeholder = commands.createEntity();
+            commands.addComponent(placeholder, Counter{5});
+            commands.playback(manager);
+
+            expect(placeholder.index).toBe(Entity::Index(0));
+            expect(countEntities(manager)).toBe(size_t(1));
+        });
+
+        it("rejects placeholders it didn't issue", [&] {
+            ComponentManager manager;
+            CommandBuffer commands;
+            Entity placeholder = commands.createEntity();
+            commands.addComponent(placeholder, Counter{1});
+            commands.addComponent(Entity{1000000, 0}, Counter{2});
+
+            expect(throws<std::invalid_argument>([&] {
+                commands.playback(manager);
+            })).toBe(true);
+            expect(countEntities(manager)).toBe(size_t(0));
+            expect(commands.empty()).toBe(true);
+        });
+
+        it("rejects placeholders from a previous playback", [&] {
+            ComponentManager manager;
+            CommandBuffer commands;
+            Entity placeholder = commands.createEntity();
+            commands.playback(manager);
+            commands.addComponent(placeholder, Counter{1});
+
+            expect(throws<std::invalid_argument>([&] {
+                commands.playback(manager);
+            })).toBe(true);
+        });
+    });
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "engine/entity-system/ComponentManager.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using engine::entitysystem::ComponentManager;
+using engine::entitysystem::Entity;
+using test::before;
+using test::describe;
+using test::it;
+
+namespace {
+    struct GroupPosition {
+        int x = 0;
+    };
+
+    struct GroupVelocity {
+        int dx = 0;
+    };
+
+    struct GroupSprite {
+        int id = 0;
+    };
+
+    // Visits the grouped entities, checking that each one gets its own data
+    std::vector<Entity::Index> visitGroup(ComponentManager& manager, bool& consistent) {
+        std::vector<Entity::Index> visited;
+        consistent = true;
+
+        manager.forEachEntity<GroupPosition, GroupVelocity>(
+            [&](Entity entity, GroupPosition& position, GroupVelocity& velocity) {
+                visited.push_back(entity.index);
+                consistent = consistent
+                    && position.x == static_cast<int>(entity.index)
+                    && velocity.dx == -static_cast<int>(entity.index);
+            }
+        );
+
+        std::sort(visited.begin(), visited.end());
+        return visited;
+    }
+}
+
+void testGroups() {
+    describe("Groups", [&] {
+        ComponentManager manager;
+        std::vector<Entity> entities;
+
+        before([&] {
+            for (Entity entity : entities) {
+                manager.deleteEntity(entity);
+            }
+
+            manager.cleanup();
+            entities.clear();
+
+            for (int i = 0; i < 6; ++i) {
+                Entity entity = manager.createEntity();
+                manager.addComponent(entity, GroupPosition{static_cast<int>(entity.index)});
+
+                if (i % 2 == 0) {
+                    manager.addComponent(entity, GroupVelocity{-static_cast<int>(entity.index)});
+                }
+
+                entities.push_back(entity);
+            }
+        });
+
+        it("includes the entities that existed before grouping", [&] {
+            manager.group<GroupPosition, GroupVelocity>();
+            bool consistent;
+            auto visited = visitGroup(manager, consistent);
+
+            expect(visited.size()).toBe(size_t(3));
+            expect(consistent).toBe(true);
+        });
+
+        it("keeps up with additions and removals", [&] {
+            manager.group<GroupPosition, GroupVelocity>();
+            manager.addComponent(entities[1], GroupVelocity{-static_cast<int>(entities[1].index)});
+            manager.removeComponent<GroupVelocity>(entities[0]);
+            manager.removeComponent<GroupPosition>(entities[2]);
+            bool consistent;
+            auto visited = visitGroup(manager, consistent);
+
+            std::vector<Entity::Index> expected{entities[1].index, entities[4].index};
+            std::sort(expected.begin(), expected.end());
+
+            expect(visited == expected).toBe(true);
+            expect(consistent).toBe(true);
+        });
+
+        it("skips deleted entities", [&] {
+            manager.group<GroupPosition, GroupVelocity>();
+            manager.deleteEntity(entities[4]);
+            bool consistent;
+            auto visited = visitGroup(manager, consistent);
+            manager.restoreEntity(entities[4]);
+
+            expect(visited.size()).toBe(size_t(2));
+            expect(consistent).toBe(true);
+        });
+
+        it("allows a component in a single group only", [&] {
+            manager.group<GroupPosition, GroupVelocity>();
+
+            expect(throws<std::logic_error>([&] {
+                manager.group<GroupPosition, GroupSprite>();
+            })).toBe(true);
+        });
+    });
+}
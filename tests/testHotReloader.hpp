@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "engine/entity-system/include.hpp"
+#include "engine/resource-system/include.hpp"
+#include "engine/utils/debug/debug.hpp"
+#include "HotReloader.hpp"
+#include "ResourceFiles.hpp"
+#include "engine/testing/include.hpp"
+
+using engine::entitysystem::ComponentManager;
+using engine::resourcesystem::ResourceStorage;
+using test::describe;
+using test::it;
+
+namespace {
+    std::string readFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    }
+
+    void writeFile(const std::string& filename, const std::string& contents) {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file << contents;
+    }
+
+    // A new directory under /tmp, removed with the files written to it
+    class TempDirectory {
+     public:
+        TempDirectory() {
+            char name[] = "/tmp/hot-reloader-XXXXXX";
+
+            if (!mkdtemp(name)) {
+                throw std::runtime_error("Failed to create a temporary directory");
+            }
+
+            path = name;
+        }
+
+        ~TempDirectory() {
+            for (auto it = paths.rbegin(); it != paths.rend(); ++it) {
+                ::remove(it->c_str());
+            }
+
+            ::rmdir(path.c_str());
+        }
+
+        // Creates a folder inside, returning its path with a slash
+        std::string makeFolder(const std::string& name) {
+            std::string folder = path + "/" + name;
+            ::mkdir(folder.c_str(), 0700);
+            paths.push_back(folder);
+            return folder + "/";
+        }
+
+        // Copies a file into a folder created by makeFolder()
+        std::string copy(const std::string& filename, const std::string& folder) {
+            std::string copied = folder + filename.substr(filename.rfind('/') + 1);
+            writeFile(copied, readFile(filename));
+            paths.push_back(copied);
+            return copied;
+        }
+
+     private:
+        std::string path;
+        // Everything created inside, in order
+        std::vector<std::string> paths;
+    };
+
+    // Updates the reloader until it logs `text`, or a few seconds pass
+    bool updateUntil(HotReloader& reloader, const std::ostringstream& log, const std::string& text) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (log.str().find(text) == std::string::npos) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            reloader.update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return true;
+    }
+}
+
+// Copies the files of resources/json, so it must run from the root of the
+// repository
+void testHotReloader() {
+    describe("HotReloader", [&] {
+        it("reports a truncated data file and applies the next save", [&] {
+            TempDirectory directory;
+            HotReloader::Paths paths;
+            paths.jsonFolder = directory.makeFolder("json");
+            paths.scriptsFolder = directory.makeFolder("scripts");
+            paths.encounters = directory.copy(ResourceFiles::ENCOUNTERS, paths.jsonFolder);
+            paths.maps = directory.copy(ResourceFiles::MAPS, paths.jsonFolder);
+            paths.moves = directory.copy(ResourceFiles::MOVES, paths.jsonFolder);
+            paths.pokemon = directory.copy(ResourceFiles::POKEMON, paths.jsonFolder);
+            paths.tiles = directory.copy(ResourceFiles::TILES, paths.jsonFolder);
+
+            ResourceStorage storage;
+            ComponentManager manager;
+            HotReloader reloader(storage, manager, paths);
+            std::ostringstream log;
+            DEBUG_REDIRECT(log);
+
+            std::string moves = readFile(paths.moves);
+            writeFile(paths.moves, moves.substr(0, moves.size() / 2));
+            expect(updateUntil(reloader, log, "[HOT RELOAD] Failed: ")).toBe(true);
+
+            // The failed reload didn't touch the digests, so the restored
+            // file has no changes
+            writeFile(paths.moves, moves);
+            expect(updateUntil(reloader, log, paths.moves + ": 0 record(s) updated")).toBe(true);
+            DEBUG_REDIRECT(std::cout);
+        });
+    });
+}
@@ -0,0 +1,166 @@
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "engine/resource-system/json/JsonBinding.hpp"
+#include "engine/resource-system/json/parse-json.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using test::describe;
+using test::it;
+
+namespace {
+    struct BoundPoint {
+        int x = 0;
+        int y = 0;
+    };
+
+    struct BoundSpecies {
+        std::string name;
+        int level = 0;
+        double weight = 0;
+        bool legendary = false;
+        std::vector<std::string> types;
+        BoundPoint position;
+        std::unordered_map<std::string, int> stats;
+        std::vector<std::string> evolutions;
+        int generation = 1;
+        JsonValue extra;
+    };
+
+    // Returns the message of the std::runtime_error thrown by binding the
+    // input, or nothing if it's bound successfully
+    template<typename T>
+    std::string bindError(std::string_view input, T& target) {
+        try {
+            bindJSON(input, target);
+        } catch (const std::runtime_error& error) {
+            return error.what();
+        }
+
+        return "";
+    }
+}
+
+template<>
+struct JsonBinding<BoundPoint> {
+    static constexpr auto elements = std::make_tuple(&BoundPoint::x, &BoundPoint::y);
+};
+
+template<>
+struct JsonBinding<BoundSpecies> {
+    static constexpr auto fields = std::make_tuple(
+        jsonField("name", &BoundSpecies::name),
+        jsonField("level", &BoundSpecies::level),
+        jsonField("weight", &BoundSpecies::weight),
+        jsonField("legendary", &BoundSpecies::legendary),
+        jsonField("types", &BoundSpecies::types),
+        jsonField("position", &BoundSpecies::position),
+        jsonField("stats", &BoundSpecies::stats),
+        jsonOptional("evolutions", &BoundSpecies::evolutions),
+        jsonOptional("generation", &BoundSpecies::generation),
+        jsonOptional("extra", &BoundSpecies::extra)
+    );
+};
+
+void testJsonBinding() {
+    describe("bindJSON", [&] {
+        const std::string complete = R"({
+            "name": "Pidgey",
+            "level": 5,
+            "weight": 1.8,
+            "legendary": false,
+            "types": ["NORMAL", "FLYING"],
+            "position": [3, 4],
+            "stats": {"hp": 40, "speed": 56},
+            "evolutions": ["Pidgeotto"],
+            "generation": 2,
+            "extra": {"note": [1, 2]}
+        })";
+
+        it("reads every field of a bound struct", [&] {
+            BoundSpecies species;
+            bindJSON(std::string_view(complete), species);
+            expect(species.name).toBe(std::string("Pidgey"));
+            expect(species.level).toBe(5);
+            expect(species.weight).toBe(1.8);
+            expect(species.types.size()).toBe(size_t(2));
+            expect(species.types[1]).toBe(std::string("FLYING"));
+            expect(species.position.y).toBe(4);
+            expect(species.stats["speed"]).toBe(56);
+            expect(species.evolutions.size()).toBe(size_t(1));
+            expect(species.evolutions[0]).toBe(std::string("Pidgeotto"));
+            expect(species.generation).toBe(2);
+            expect(species.extra["note"][1].asInt()).toBe(2);
+        });
+
+        it("reads the same from a parsed value", [&] {
+            BoundSpecies species;
+            bindJSON(parseJSON(complete), species);
+            expect(species.name).toBe(std::string("Pidgey"));
+            expect(species.stats["hp"]).toBe(40);
+        });
+
+        it("rejects keys without a field", [&] {
+            BoundSpecies species;
+            std::string input = R"({"name": "Pidgey", "nickname": "Pidge"})";
+            expect(bindError(input, species)).toBe(std::string("Unknown JSON key: nickname"));
+            expect(throws<std::runtime_error>([&] { bindJSON(parseJSON(input), species); })).toBe(true);
+        });
+
+        it("rejects objects missing the key of a required field", [&] {
+            BoundSpecies species;
+            std::string input = R"({
+                "name": "Pidgey", "level": 5, "weight": 1.8, "legendary": false,
+                "types": [], "stats": {}
+            })";
+            expect(bindError(input, species)).toBe(std::string("Missing JSON key: position"));
+        });
+
+        it("leaves optional fields as they were when their key is missing", [&] {
+            BoundSpecies species;
+            std::string input = R"({
+                "name": "Pidgey", "level": 5, "weight": 1.8, "legendary": false,
+                "types": [], "position": [0, 0], "stats": {}
+            })";
+            expect(bindError(input, species)).toBe(std::string());
+            expect(species.evolutions.empty()).toBe(true);
+            expect(species.generation).toBe(1);
+        });
+
+        it("counts null values as present", [&] {
+            BoundSpecies species;
+            species.level = 7;
+            std::string input = R"({
+                "name": "Pidgey", "level": null, "weight": 1.8, "legendary": false,
+                "types": [], "position": [0, 0], "stats": {}
+            })";
+            expect(bindError(input, species)).toBe(std::string());
+            expect(species.level).toBe(7);
+        });
+
+        it("checks every object of a table", [&] {
+            std::vector<std::pair<std::string, BoundSpecies>> table;
+            std::string input = R"({"pidgey": )" + complete + R"(, "rattata": {"name": "Rattata"}})";
+            expect(bindError(input, table)).toBe(std::string("Missing JSON key: level"));
+        });
+
+        it("accepts any key in maps", [&] {
+            std::unordered_map<std::string, int> values;
+            bindJSON(std::string_view(R"({"anything": 1, "else": 2})"), values);
+            expect(values.size()).toBe(size_t(2));
+        });
+
+        it("rejects values of the wrong type", [&] {
+            BoundSpecies species;
+            std::string input = R"({"name": 1})";
+            expect(bindError(input, species)).toBe(std::string("Unexpected JSON integer"));
+            input = R"({"types": {}})";
+            expect(bindError(input, species)).toBe(std::string("Unexpected JSON object"));
+        });
+    });
+}
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "engine/resource-system/json/JsonBinding.hpp"
+#include "engine/resource-system/json/parse-json.hpp"
+#include "engine/testing/include.hpp"
+
+using test::describe;
+using test::it;
+
+namespace {
+    struct BoundMeasures {
+        float height = 0;
+        double weight = 0;
+        int level = 0;
+        uint8_t accuracy = 0;
+    };
+
+    // Returns the message of the std::runtime_error thrown by `action`, or
+    // nothing if it doesn't throw
+    template<typename Action>
+    std::string errorOf(Action action) {
+        try {
+            action();
+        } catch (const std::runtime_error& error) {
+            return error.what();
+        }
+
+        return "";
+    }
+
+    std::string parseError(std::string_view input) {
+        return errorOf([&] { parseJSON(input); });
+    }
+
+    std::string bindError(std::string_view input) {
+        BoundMeasures measures;
+        return errorOf([&] { bindJSON(input, measures); });
+    }
+}
+
+template<>
+struct JsonBinding<BoundMeasures> {
+    static constexpr auto fields = std::make_tuple(
+        jsonOptional("height", &BoundMeasures::height),
+        jsonOptional("weight", &BoundMeasures::weight),
+        jsonOptional("level", &BoundMeasures::level),
+        jsonOptional("accuracy", &BoundMeasures::accuracy)
+    );
+};
+
+void testJsonNumbers() {
+    describe("JSON numbers", [&] {
+        it("reads the limits of 64 bit integers as integers", [&] {
+            JsonValue numbers = parseJSON("[9223372036854775807, -9223372036854775808]");
+            expect(numbers[0].is<int64_t>()).toBe(true);
+            expect(numbers[0].asInt64()).toBe(std::numeric_limits<int64_t>::max());
+            expect(numbers[1].asInt64()).toBe(std::numeric_limits<int64_t>::min());
+        });
+
+        it("reads integers beyond 64 bits as doubles", [&] {
+            JsonValue numbers = parseJSON("[9223372036854775808, -9223372036854775809, 123456789012345678901234567890]");
+            expect(numbers[0].is<double>()).toBe(true);
+            expect(numbers[0].asDouble()).toBe(9223372036854775808.0);
+            expect(numbers[1].asDouble()).toBe(-9223372036854775808.0);
+            expect(numbers[2].asDouble()).toBe(1.2345678901234568e29);
+        });
+
+        it("reads integers as doubles when asked", [&] {
+            expect(parseJSON("-42").asDouble()).toBe(-42.0);
+        });
+
+        it("keeps the sign of -0", [&] {
+            JsonValue zeros = parseJSON("[-0, -0.0, 0, 0.0]");
+            expect(zeros[0].is<double>()).toBe(true);
+            expect(std::signbit(zeros[0].asDouble())).toBe(true);
+            expect(std::signbit(zeros[1].asDouble())).toBe(true);
+            expect(zeros[2].is<int64_t>()).toBe(true);
+            expect(std::signbit(zeros[3].asDouble())).toBe(false);
+        });
+
+        it("reads fractions and exponents", [&] {
+            JsonValue numbers = parseJSON("[0.5, -12.25, 1e2, 1E2, 2.5e+3, 25e-1, -1.5E-2, 0e999]");
+            expect(numbers[0].asDouble()).toBe(0.5);
+            expect(numbers[1].asDouble()).toBe(-12.25);
+            expect(numbers[2].is<double>()).toBe(true);
+            expect(numbers[2].asDouble()).toBe(100.0);
+            expect(numbers[3].asDouble()).toBe(100.0);
+            expect(numbers[4].asDouble()).toBe(2500.0);
+            expect(numbers[5].asDouble()).toBe(2.5);
+            expect(numbers[6].asDouble()).toBe(-0.015);
+            expect(numbers[7].asDouble()).toBe(0.0);
+        });
+
+        it("rounds doubles to the nearest one", [&] {
+            JsonValue numbers = parseJSON(
+                "[0.1, 0.30000000000000004, 9007199254740993.0, 2.2250738585072014e-308, "
+                "1.7976931348623157e308, 4.9e-324]"
+            );
+            expect(numbers[0].asDouble()).toBe(0.1);
+            expect(numbers[1].asDouble() == 0.3).toBe(false);
+            expect(numbers[1].asDouble()).toBe(0.1 + 0.2);
+            // Halfway between two doubles, so it rounds to the even one
+            expect(numbers[2].asDouble()).toBe(9007199254740992.0);
+            expect(numbers[3].asDouble()).toBe(std::numeric_limits<double>::min());
+            expect(numbers[4].asDouble()).toBe(std::numeric_limits<double>::max());
+            expect(numbers[5].asDouble()).toBe(std::numeric_limits<double>::denorm_min());
+        });
+
+        it("reads numbers too close to zero as zero", [&] {
+            JsonValue numbers = parseJSON("[1e-400, -2.4e-324, 0.0000001e-320, 1e-99999999999999999999]");
+            expect(numbers[0].asDouble()).toBe(0.0);
+            expect(std::signbit(numbers[1].asDouble())).toBe(true);
+            expect(numbers[2].asDouble()).toBe(0.0);
+            expect(numbers[3].asDouble()).toBe(0.0);
+        });
+
+        it("rejects numbers too large for a double", [&] {
+            expect(parseError("1e400")).toBe(std::string("Number out of range: 1e400"));
+            expect(parseError("-1.8e308")).toBe(std::string("Number out of range: -1.8e308"));
+            expect(parseError("1000000000000000000000000e300")).toBe(std::string("Number out of range: 1000000000000000000000000e300"));
+            expect(parseError("0.001e312")).toBe(std::string("Number out of range: 0.001e312"));
+            expect(parseError("1e99999999999999999999")).toBe(std::string("Number out of range: 1e99999999999999999999"));
+        });
+
+        it("rejects literals JSON doesn't allow", [&] {
+            expect(parseError("01")).toBe(std::string("Invalid number literal, leading zero: 01"));
+            expect(parseError("-007")).toBe(std::string("Invalid number literal, leading zero: -00"));
+
+            for (std::string_view input : {"1.", ".5", "-", "1e", "1e+", "+1", "0x10", "NaN", "Infinity"}) {
+                expect(parseError(input).empty()).toBe(false);
+            }
+        });
+    });
+
+    describe("bindJSON with numbers", [&] {
+        it("reads floating point members from integers and doubles", [&] {
+            BoundMeasures measures;
+            bindJSON(std::string_view(R"({"height": 7, "weight": 1.8})"), measures);
+            expect(measures.height).toBe(7.0f);
+            expect(measures.weight).toBe(1.8);
+
+            bindJSON(std::string_view(R"({"height": 0.7, "weight": 9223372036854775807})"), measures);
+            expect(measures.height).toBe(0.7f);
+            expect(measures.weight).toBe(9223372036854775807.0);
+        });
+
+        it("doesn't read integer members from doubles", [&] {
+            expect(bindError(R"({"level": 5.0})")).toBe(std::string("Unexpected JSON number"));
+            expect(bindError(R"({"level": 5e0})")).toBe(std::string("Unexpected JSON number"));
+            expect(bindError(R"({"level": -0})")).toBe(std::string("Unexpected JSON number"));
+        });
+
+        it("rejects integers that don't fit their member", [&] {
+            expect(bindError(R"({"level": 2147483647, "accuracy": 255})")).toBe(std::string());
+            expect(bindError(R"({"level": 2147483648})")).toBe(std::string("JSON integer out of range: 2147483648"));
+            expect(bindError(R"({"accuracy": 256})")).toBe(std::string("JSON integer out of range: 256"));
+            expect(bindError(R"({"accuracy": -1})")).toBe(std::string("JSON integer out of range: -1"));
+        });
+
+        it("rejects doubles that don't fit their member", [&] {
+            expect(bindError(R"({"height": 3.4e38, "weight": 1e300})")).toBe(std::string());
+            expect(bindError(R"({"height": 1e39})").empty()).toBe(false);
+            expect(bindError(R"({"height": -1e39})").empty()).toBe(false);
+        });
+    });
+}
@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "engine/resource-system/json/JsonReader.hpp"
+#include "engine/resource-system/json/parse-json.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using test::describe;
+using test::it;
+
+namespace {
+    // Writes down every event, to compare them as a single string
+    struct EventRecorder : JsonHandler {
+        std::string events;
+
+        void onStartObject() { events += "{ "; }
+        void onKey(std::string_view key) { events += "key:" + std::string(key) + " "; }
+        void onEndObject() { events += "} "; }
+        void onStartArray() { events += "[ "; }
+        void onEndArray() { events += "] "; }
+        void onString(std::string_view text) { events += "str:" + std::string(text) + " "; }
+        void onNumber(int64_t number) { events += "int:" + std::to_string(number) + " "; }
+        void onDouble(double number) { events += "dbl:" + std::to_string(number) + " "; }
+        void onBool(bool boolean) { events += boolean ? "true " : "false "; }
+        void onNull() { events += "null "; }
+    };
+
+    std::string record(std::string_view input) {
+        EventRecorder recorder;
+        readJSON(input, recorder);
+        return recorder.events;
+    }
+
+    // Returns the message of the std::runtime_error thrown by reading the
+    // input, or nothing if it's read successfully
+    std::string readError(std::string_view input) {
+        try {
+            record(input);
+        } catch (const std::runtime_error& error) {
+            return error.what();
+        }
+
+        return "";
+    }
+}
+
+void testJsonReader() {
+    describe("readJSON", [&] {
+        it("calls the handler for each event in order", [&] {
+            std::string events = record(R"({"a": [1, "two", true, null], "b": {}, "c": []})");
+            expect(events).toBe(std::string(
+                "{ key:a [ int:1 str:two true null ] key:b { } key:c [ ] } "
+            ));
+        });
+
+        it("reads a scalar root", [&] {
+            expect(record("42")).toBe(std::string("int:42 "));
+            expect(record(R"( "text" )")).toBe(std::string("str:text "));
+            expect(record("null // nothing else\n")).toBe(std::string("null "));
+        });
+
+        it("decodes escaped strings and keys", [&] {
+            expect(record(R"({"a\"b": "c\nd"})")).toBe(std::string("{ key:a\"b str:c\nd } "));
+        });
+
+        it("tells integers and doubles apart", [&] {
+            expect(record("[-3, 2.5, 1e2, 9223372036854775807, 9223372036854775808]")).toBe(std::string(
+                "[ int:-3 dbl:2.500000 dbl:100.000000 int:9223372036854775807 "
+                "dbl:9223372036854775808.000000 ] "
+            ));
+        });
+
+        it("replays a parsed value with the same events", [&] {
+            std::string input = R"({"a": [1, 2.5, "x", false, null], "b": {"c": {}}})";
+            EventRecorder recorder;
+            readJSON(parseJSON(input), recorder);
+            expect(recorder.events).toBe(record(input));
+        });
+
+        it("rejects anything after the root value", [&] {
+            expect(readError(R"({"a":1}xyz)").empty()).toBe(false);
+            expect(readError("[1] [2]")).toBe(std::string("Expected EndOfFile, got OpenBracket: ["));
+            expect(readError("1 2")).toBe(std::string("Expected EndOfFile, got NumberLiteral: 2"));
+        });
+
+        it("rejects every truncated document", [&] {
+            std::string_view input = R"({"a": [1, {"b": "c"}], "d": null})";
+            size_t rejected = 0;
+
+            for (size_t length = 0; length < input.size(); ++length) {
+                rejected += !readError(input.substr(0, length)).empty();
+            }
+
+            expect(rejected).toBe(input.size());
+        });
+
+        it("names the unexpected token", [&] {
+            expect(readError(R"({"a" 1})")).toBe(std::string("Expected Colon, got NumberLiteral: 1"));
+            expect(readError(R"({1: 2})")).toBe(std::string("Expected StringLiteral, got NumberLiteral: 1"));
+            expect(readError("[1 2]")).toBe(std::string("Expected Comma, got NumberLiteral: 2"));
+            expect(readError("[1,]")).toBe(std::string("Unexpected token CloseBracket: ]"));
+            expect(readError(R"({"a": })")).toBe(std::string("Unexpected token CloseBrace: }"));
+            expect(readError("[")).toBe(std::string("Unexpected end of input"));
+            expect(readError(R"({"a")")).toBe(std::string("Expected Colon, got end of input"));
+        });
+
+        it("throws from parseJSON on a truncated document", [&] {
+            expect(throws<std::runtime_error>([] { parseJSON(R"({"a": [1, 2)"); })).toBe(true);
+        });
+    });
+}
@@ -0,0 +1,108 @@
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "engine/resource-system/json/Scanner.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using test::describe;
+using test::it;
+
+namespace {
+    std::vector<Token> scanAll(std::string_view document) {
+        JsonScanner scanner(document);
+        std::vector<Token> tokens;
+
+        do {
+            tokens.push_back(scanner.scan());
+        } while (tokens.back().kind != TokenKind::EndOfFile);
+
+        return tokens;
+    }
+
+    std::string kindsOf(const std::vector<Token>& tokens) {
+        // One character per token, to compare whole sequences at once
+        static constexpr std::string_view symbols = "$snbz[]{}:,";
+        std::string kinds;
+
+        for (const Token& token : tokens) {
+            kinds += symbols[static_cast<size_t>(token.kind)];
+        }
+
+        return kinds;
+    }
+}
+
+void testJsonScanner() {
+    describe("JsonScanner", [&] {
+        it("splits a document into tokens", [&] {
+            auto tokens = scanAll(R"({"a": [1, true, null], "b": false})");
+            expect(kindsOf(tokens)).toBe(std::string("{s:[n,b,z],s:b}$"));
+            expect(tokens[1].text).toBe(std::string_view("a"));
+            expect(tokens[4].text).toBe(std::string_view("1"));
+            expect(tokens[13].text).toBe(std::string_view("false"));
+        });
+
+        it("points string tokens into the document", [&] {
+            std::string document = R"(["plain", "esc\"aped"])";
+            auto tokens = scanAll(document);
+            expect(tokens[1].text.data() == document.data() + 2).toBe(true);
+            expect(tokens[1].escaped).toBe(false);
+            expect(tokens[3].text).toBe(std::string_view(R"(esc\"aped)"));
+            expect(tokens[3].escaped).toBe(true);
+        });
+
+        it("skips whitespace and comments", [&] {
+            auto tokens = scanAll("// line\n[1, /* block\n */ 2]\r\n\t// last");
+            expect(kindsOf(tokens)).toBe(std::string("[n,n]$"));
+        });
+
+        it("scans numbers with fractions and exponents", [&] {
+            auto tokens = scanAll("[0, -0, 10, -2.5, 1e3, 6.02E+23, 1e-7]");
+            std::vector<std::string_view> numbers;
+
+            for (const Token& token : tokens) {
+                if (token.kind == TokenKind::NumberLiteral) {
+                    numbers.push_back(token.text);
+                }
+            }
+
+            std::vector<std::string_view> expected = {
+                "0", "-0", "10", "-2.5", "1e3", "6.02E+23", "1e-7"
+            };
+            expect(numbers == expected).toBe(true);
+        });
+
+        it("rejects invalid numbers", [&] {
+            for (std::string_view number : {"01", "-01", "00", "-", "1.", ".5", "1e", "1e+"}) {
+                bool rejected = throws<std::runtime_error>([&] { scanAll(number); });
+                expect(std::string(number) + (rejected ? " rejected" : " accepted"))
+                    .toBe(std::string(number) + " rejected");
+            }
+        });
+
+        it("rejects invalid literals and characters", [&] {
+            expect(throws<std::runtime_error>([] { scanAll("tru"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { scanAll("nul"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { scanAll("[1; 2]"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { scanAll(R"(["open)"); })).toBe(true);
+        });
+
+        it("rejects a lone slash and unterminated comments", [&] {
+            expect(throws<std::runtime_error>([] { scanAll("[1] /"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { scanAll("[1] / 2"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { scanAll("[1] /* open"); })).toBe(true);
+        });
+
+        it("decodes escape sequences", [&] {
+            expect(JsonScanner::unescape(R"(a\"b\\c\/d\n\t)")).toBe(std::string("a\"b\\c/d\n\t"));
+            expect(JsonScanner::unescape(R"(\u00e9)")).toBe(std::string("\xC3\xA9"));
+            expect(JsonScanner::unescape(R"(\u20AC)")).toBe(std::string("\xE2\x82\xAC"));
+            expect(JsonScanner::unescape(R"(\ud83d\ude00)")).toBe(std::string("\xF0\x9F\x98\x80"));
+            expect(throws<std::runtime_error>([] { JsonScanner::unescape(R"(\x)"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { JsonScanner::unescape(R"(\u12)"); })).toBe(true);
+            expect(throws<std::runtime_error>([] { JsonScanner::unescape(R"(\ud83d\u0041)"); })).toBe(true);
+        });
+    });
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "engine/resource-system/json/JsonArena.hpp"
+#include "engine/resource-system/json/JsonValue.hpp"
+#include "engine/resource-system/json/parse-json.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using test::describe;
+using test::it;
+
+void testJsonValue() {
+    describe("JsonArena", [&] {
+        it("aligns allocations", [&] {
+            JsonArena arena;
+            arena.allocate(1, 1);
+            auto address = reinterpret_cast<uintptr_t>(arena.allocate(8, 8));
+            expect(address % 8).toBe(uintptr_t(0));
+            address = reinterpret_cast<uintptr_t>(arena.allocateArray<JsonValue>(3));
+            expect(address % alignof(JsonValue)).toBe(uintptr_t(0));
+            expect(arena.allocateArray<JsonValue>(0) == nullptr).toBe(true);
+        });
+
+        it("copies strings with a null character", [&] {
+            JsonArena arena;
+            std::string text = "species";
+            std::string_view copy = arena.copyString(text);
+            text[0] = 'S';
+            expect(copy).toBe(std::string_view("species"));
+            expect(copy.data()[copy.size()]).toBe('\0');
+            expect(arena.copyString("").size()).toBe(size_t(0));
+        });
+
+        it("never moves what it allocated", [&] {
+            JsonArena arena;
+            std::vector<std::string_view> copies;
+
+            // Enough to fill several blocks, one of them larger than the
+            // largest block
+            for (int i = 0; i < 1000; ++i) {
+                copies.push_back(arena.copyString(std::to_string(i)));
+            }
+
+            std::string_view large = arena.copyString(std::string(2 << 20, 'x'));
+
+            bool kept = true;
+
+            for (int i = 0; i < 1000; ++i) {
+                kept = kept && copies[i] == std::to_string(i);
+            }
+
+            expect(kept).toBe(true);
+            expect(large.size()).toBe(size_t(2 << 20));
+            expect(large.back()).toBe('x');
+        });
+    });
+
+    describe("JsonValue", [&] {
+        it("reads a parsed document", [&] {
+            JsonValue document = parseJSON(R"({"b": [1, 2.5, "three"], "a": {"c": null, "d": true}})");
+            expect(document.type() == JsonValue::Type::Object).toBe(true);
+            expect(document["b"].asIterableArray().size()).toBe(size_t(3));
+            expect(document["b"][0].asInt()).toBe(1);
+            expect(document["b"][1].asDouble()).toBe(2.5);
+            expect(document["b"][2].asString()).toBe(std::string("three"));
+            expect(document["a"]["c"].is<std::nullptr_t>()).toBe(true);
+            expect(document["a"]["d"].asBool()).toBe(true);
+            expect(document["a"].asIterableMap().count("e")).toBe(size_t(0));
+        });
+
+        it("keeps the members of an object in document order", [&] {
+            JsonValue document = parseJSON(R"({"z": 1, "a": 2, "m": 3})");
+            std::string keys;
+
+            for (const auto& [key, value] : document.asIterableMap()) {
+                keys += key;
+            }
+
+            expect(keys).toBe(std::string("zam"));
+        });
+
+        it("doesn't point into the input", [&] {
+            std::string input = R"({"name": "Pidgey"})";
+            JsonValue document = parseJSON(input);
+            std::string_view name = document["name"].asStringView();
+            expect(name.data() >= input.data() && name.data() < input.data() + input.size())
+                .toBe(false);
+
+            input.assign(input.size(), ' ');
+            expect(document["name"].asString()).toBe(std::string("Pidgey"));
+        });
+
+        it("shares the document between copies of the root", [&] {
+            JsonValue copy;
+
+            {
+                JsonValue document = parseJSON(R"({"moves": ["tackle", "growl"]})");
+                copy = document;
+                expect(copy["moves"][0].asStringView().data() == document["moves"][0].asStringView().data())
+                    .toBe(true);
+            }
+
+            expect(copy["moves"][1].asString()).toBe(std::string("growl"));
+        });
+
+        it("copies a value inside a document with its children", [&] {
+            JsonValue moves;
+
+            {
+                JsonValue document = parseJSON(R"({"moves": ["tackle", "growl"]})");
+                moves = document["moves"];
+                expect(moves[0].asStringView().data() == document["moves"][0].asStringView().data())
+                    .toBe(false);
+            }
+
+            expect(moves[0].asString()).toBe(std::string("tackle"));
+            expect(moves[1].asString()).toBe(std::string("growl"));
+        });
+
+        it("copies built values into an arena of their own", [&] {
+            std::string name = "Rattata";
+            JsonValue value(std::unordered_map<std::string, JsonValue>{
+                {"name", name},
+                {"levels", std::vector<JsonValue>{2, 3}}
+            });
+            name = "Pidgey";
+
+            expect(value["name"].asString()).toBe(std::string("Rattata"));
+            expect(value["levels"][1].asInt()).toBe(3);
+
+            JsonValue empty(std::vector<JsonValue>{});
+            expect(empty.asIterableArray().empty()).toBe(true);
+        });
+
+        it("throws on missing members and indexes", [&] {
+            JsonValue document = parseJSON(R"({"list": [1]})");
+            expect(throws<std::out_of_range>([&] { document.at("missing"); })).toBe(true);
+            expect(throws<std::out_of_range>([&] { document["list"].at(1); })).toBe(true);
+        });
+    });
+}
@@ -0,0 +1,130 @@
+#include <stdexcept>
+#include <vector>
+#include "engine/entity-system/ComponentManager.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using engine::entitysystem::ComponentManager;
+using engine::entitysystem::Entity;
+using test::before;
+using test::describe;
+using test::it;
+
+namespace {
+    // Counts its copies, to tell which pages were duplicated
+    struct CopyCounted {
+        CopyCounted(int value = 0) : value(value) {}
+
+        CopyCounted(const CopyCounted& other) : value(other.value) {
+            ++copies;
+        }
+
+        CopyCounted& operator=(const CopyCounted& other) {
+            value = other.value;
+            ++copies;
+            return *this;
+        }
+
+        int value;
+        static inline size_t copies = 0;
+    };
+}
+
+void testSnapshot() {
+    describe("ComponentManager snapshots", [&] {
+        ComponentManager manager;
+        std::vector<Entity> entities;
+
+        before([&] {
+            for (Entity entity : entities) {
+                manager.deleteEntity(entity);
+            }
+
+            manager.cleanup();
+            entities.clear();
+
+            for (int i = 0; i < 10; ++i) {
+                Entity entity = manager.createEntity();
+                manager.addComponent(entity, CopyCounted(i));
+                entities.push_back(entity);
+            }
+
+            CopyCounted::copies = 0;
+        });
+
+        it("doesn't copy components when taken", [&] {
+            auto snapshot = manager.snapshot();
+            const ComponentManager& reader = manager;
+            int sum = 0;
+
+            for (Entity entity : entities) {
+                sum += reader.getData<CopyCounted>(entity).value;
+            }
+
+            expect(sum).toBe(45);
+            expect(CopyCounted::copies).toBe(size_t(0));
+        });
+
+        it("copies a shared page once, right before writing it", [&] {
+            auto snapshot = manager.snapshot();
+            manager.getData<CopyCounted>(entities[0]).value = 100;
+            size_t copiesAfterFirstWrite = CopyCounted::copies;
+            manager.getData<CopyCounted>(entities[1]).value = 101;
+
+            expect(copiesAfterFirstWrite).toBe(entities.size());
+            expect(CopyCounted::copies).toBe(copiesAfterFirstWrite);
+            expect(manager.getData<CopyCounted>(entities[0]).value).toBe(100);
+        });
+
+        it("brings back written, removed and destroyed components", [&] {
+            auto snapshot = manager.snapshot();
+            manager.getData<CopyCounted>(entities[2]).value = 200;
+            manager.removeComponent<CopyCounted>(entities[3]);
+            manager.deleteEntity(entities[4]);
+            manager.cleanup();
+            Entity created = manager.createEntity();
+            manager.addComponent(created, CopyCounted(300));
+
+            manager.restore(snapshot);
+
+            expect(manager.getData<CopyCounted>(entities[2]).value).toBe(2);
+            expect(manager.getData<CopyCounted>(entities[3]).value).toBe(3);
+            expect(manager.isValid(entities[4])).toBe(true);
+            expect(manager.getData<CopyCounted>(entities[4]).value).toBe(4);
+            expect(manager.hasComponent<CopyCounted>(created)).toBe(false);
+        });
+
+        it("only marks the restored pages as changed", [&] {
+            auto snapshot = manager.snapshot();
+            auto tick = manager.advanceTick();
+            manager.restore(snapshot);
+
+            expect(manager.hasChangedSince<CopyCounted>(entities[0], tick)).toBe(false);
+
+            manager.getData<CopyCounted>(entities[0]).value = 100;
+            tick = manager.advanceTick();
+            manager.restore(snapshot);
+
+            expect(manager.hasChangedSince<CopyCounted>(entities[0], tick)).toBe(true);
+            expect(manager.getData<CopyCounted>(entities[0]).value).toBe(0);
+        });
+
+        it("can be restored several times", [&] {
+            auto snapshot = manager.snapshot();
+
+            for (int value : {10, 20}) {
+                manager.getData<CopyCounted>(entities[5]).value = value;
+                manager.restore(snapshot);
+            }
+
+            expect(manager.getData<CopyCounted>(entities[5]).value).toBe(5);
+        });
+
+        it("can't be restored into another manager", [&] {
+            auto snapshot = manager.snapshot();
+            ComponentManager other;
+
+            expect(throws<std::logic_error>([&] { other.restore(snapshot); })).toBe(true);
+        });
+    });
+}
@@ -0,0 +1,123 @@
+#include <stdexcept>
+#include "engine/entity-system/ComponentManager.hpp"
+#include "engine/entity-system/SparseSet.hpp"
+#include "engine-test-utils.hpp"
+#include "engine/testing/include.hpp"
+
+using engine::entitysystem::ComponentManager;
+using engine::entitysystem::Entity;
+using engine::entitysystem::SparseSet;
+using test::before;
+using test::describe;
+using test::it;
+
+namespace {
+    struct Health {
+        int value = 0;
+    };
+}
+
+void testSparseSet() {
+    describe("SparseSet", [&] {
+        it("grows one page at a time without moving the components", [&] {
+            SparseSet<Health> set;
+            set.emplace({0, 1}, Health{10});
+            Health* first = &set.get({0, 1});
+            size_t pageCapacity = set.capacity();
+
+            for (Entity::Index index = 1; index <= pageCapacity; ++index) {
+                set.emplace({index, 1}, Health{static_cast<int>(index)});
+            }
+
+            expect(set.size()).toBe(pageCapacity + 1);
+            expect(set.capacity()).toBe(2 * pageCapacity);
+            expect(&set.get({0, 1}) == first).toBe(true);
+            expect(set.get({0, 1}).value).toBe(10);
+
+            set.clear();
+            set.shrinkToFit();
+            expect(set.capacity()).toBe(size_t(0));
+        });
+
+        it("does nothing when emplacing an existing entity", [&] {
+            SparseSet<Health> set;
+            expect(set.emplace({3, 1}, Health{1})).toBe(true);
+            expect(set.emplace({3, 1}, Health{2})).toBe(false);
+            expect(set.size()).toBe(size_t(1));
+            expect(set.get({3, 1}).value).toBe(1);
+        });
+
+        it("moves the last component into the erased slot", [&] {
+            SparseSet<Health> set;
+            set.emplace({0, 1}, Health{0});
+            set.emplace({1, 1}, Health{1});
+            set.emplace({2, 1}, Health{2});
+            set.erase({0, 1});
+
+            expect(set.size()).toBe(size_t(2));
+            expect(set.contains({0, 1})).toBe(false);
+            expect(set.entityAt(0)).toBe(Entity{2, 1});
+            expect(set.dataAt(0).value).toBe(2);
+            expect(set.indexOf({2, 1})).toBe(size_t(0));
+            expect(set.indexOf({1, 1})).toBe(size_t(1));
+        });
+
+        it("supports sparse indexes far apart", [&] {
+            SparseSet<Health> set;
+            set.emplace({5, 1}, Health{5});
+            set.emplace({1000000, 1}, Health{7});
+
+            expect(set.get({1000000, 1}).value).toBe(7);
+            expect(set.contains({999999, 1})).toBe(false);
+            expect(set.contains({2000000, 1})).toBe(false);
+        });
+
+        it("rejects stale handles", [&] {
+            SparseSet<Health> set;
+            set.emplace({4, 2}, Health{42});
+
+            expect(set.contains({4, 1})).toBe(false);
+            expect(set.indexOf({4, 1}) >= set.size()).toBe(true);
+            expect(throws<std::out_of_range>([&] { set.get({4, 1}); })).toBe(true);
+
+            set.erase({4, 1});
+            expect(set.size()).toBe(size_t(1));
+            expect(set.get({4, 2}).value).toBe(42);
+        });
+    });
+
+    describe("ComponentManager entities", [&] {
+        ComponentManager manager;
+        Entity entity;
+
+        before([&] {
+            entity = manager.createEntity();
+            manager.addComponent(entity, Health{1});
+            manager.deleteEntity(entity);
+            manager.cleanup();
+        });
+
+        it("reuses destroyed indexes with a new version", [&] {
+            Entity reused = manager.createEntity();
+
+            expect(reused.index).toBe(entity.index);
+            expect(reused.version).toBe(entity.version + 1);
+            expect(manager.isValid(entity)).toBe(false);
+            expect(manager.isValid(reused)).toBe(true);
+        });
+
+        it("doesn't expose components through stale handles", [&] {
+            Entity reused = manager.createEntity();
+            manager.addComponent(reused, Health{2});
+
+            expect(manager.hasComponent<Health>(entity)).toBe(false);
+            expect(manager.getData<Health>(reused).value).toBe(2);
+            expect(throws<std::out_of_range>([&] {
+                manager.getData<Health>(entity);
+            })).toBe(true);
+            expect(throws<std::invalid_argument>([&] {
+                manager.addComponent<Health>(entity);
+            })).toBe(true);
+        });
+    });
+}
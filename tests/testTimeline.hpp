@@ -0,0 +1,87 @@
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "engine/utils/timing/count-allocations.hpp"
+#include "engine/utils/timing/Timeline.hpp"
+#include "engine/testing/include.hpp"
+
+using engine::utils::ScopedTimer;
+using engine::utils::Timeline;
+using test::describe;
+using test::it;
+
+namespace {
+    // Allocated through the aligned operator new
+    struct alignas(64) CacheLine {
+        char bytes[64];
+    };
+}
+
+void testTimeline() {
+    describe("Timeline", [&] {
+        it("counts the allocations made while a timer measures", [&] {
+            Timeline timeline;
+
+            {
+                ScopedTimer timer("allocate", timeline);
+                auto number = std::make_unique<int>(1);
+                auto line = std::make_unique<CacheLine>();
+                std::vector<int> numbers(10);
+            }
+
+            {
+                ScopedTimer timer("nothing", timeline);
+            }
+
+            auto events = timeline.events();
+            expect(events.size()).toBe(size_t(2));
+
+            // Both may start in the same microsecond, so they're told apart
+            // by name
+            for (const auto& event : events) {
+                expect(event.allocations.value_or(size_t(-1))).toBe(size_t(event.name == "allocate" ? 3 : 0));
+            }
+        });
+
+        it("writes n/a for events whose allocations weren't counted", [&] {
+            Timeline timeline;
+            timeline.record({"uncounted", 0, 0, 1000, 0, std::nullopt, 0});
+            timeline.record({"counted", 0, 2000, 1000, 0, 7, 0});
+
+            std::ostringstream summary;
+            timeline.writeSummary(summary);
+            expect(summary.str().find("n/a  ") != std::string::npos).toBe(true);
+            expect(summary.str().find("      7 ") != std::string::npos).toBe(true);
+
+            std::ostringstream trace;
+            timeline.writeChromeTrace(trace);
+            expect(trace.str().find("\"allocations\":\"n/a\"") != std::string::npos).toBe(true);
+            expect(trace.str().find("\"allocations\":7,") != std::string::npos).toBe(true);
+        });
+
+        it("adds what inner timers read to the timers enclosing them", [&] {
+            Timeline timeline;
+
+            {
+                ScopedTimer outer("outer", timeline);
+                outer.addBytesRead(10);
+
+                {
+                    ScopedTimer inner("inner", timeline);
+                    ScopedTimer::recordBytesRead(5);
+                }
+            }
+
+            auto events = timeline.events();
+            expect(events.size()).toBe(size_t(2));
+
+            // Both may start in the same microsecond and last as long, so
+            // their order isn't known
+            for (const auto& event : events) {
+                expect(event.bytesRead).toBe(size_t(event.name == "outer" ? 15 : 5));
+            }
+        });
+    });
+}